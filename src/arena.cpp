@@ -10,6 +10,44 @@ Arena::Arena (Internal * i) {
 Arena::~Arena () {
   delete [] from.start;
   delete [] to.start;
+  release ();
+}
+
+// Header of a 'learned' chunk, linking it to the previous chunk.
+
+struct ArenaChunk { char * start, * end; };
+
+static const size_t arena_chunk_header =
+  align (sizeof (ArenaChunk), 8);
+
+static const size_t arena_min_chunk_bytes = (size_t) 1 << 20;
+
+void Arena::grow (size_t bytes) {
+  size_t old_bytes = learned.end - learned.start;
+  size_t new_bytes = 2*old_bytes;
+  if (new_bytes < arena_min_chunk_bytes)
+    new_bytes = arena_min_chunk_bytes;
+  if (new_bytes < bytes + arena_chunk_header)
+    new_bytes = bytes + arena_chunk_header;
+  LOG ("allocating new 'learned' chunk of arena with %zd bytes", new_bytes);
+  char * start = new char[new_bytes];
+  ArenaChunk * chunk = (ArenaChunk *) start;
+  chunk->start = learned.start;
+  chunk->end = learned.end;
+  learned.start = start;
+  learned.top = start + arena_chunk_header;
+  learned.end = start + new_bytes;
+}
+
+void Arena::release () {
+  char * start = learned.start;
+  while (start) {
+    ArenaChunk * chunk = (ArenaChunk *) start;
+    char * prev = chunk->start;
+    delete [] start;
+    start = prev;
+  }
+  learned.start = learned.top = learned.end = 0;
 }
 
 void Arena::prepare (size_t bytes) {
@@ -25,6 +63,10 @@ void Arena::swap () {
     (size_t) (from.end - from.start));
   from = to;
   to.start = to.top = to.end = 0;
+  if (learned.start) {
+    LOG ("delete 'learned' chunks of arena");
+    release ();
+  }
 }
 
 }
@@ -51,6 +51,16 @@ namespace CaDiCaL {
 //
 // One has to be really careful with 'qi' references to arena memory.
 
+// Optionally ('opts.arenalearn') new learned clauses are not allocated with
+// 'new' but bump allocated in a chain of geometrically growing 'learned'
+// chunks owned by the arena.  This avoids the overhead of calling the
+// system allocator for every learned clause and the fragmentation caused
+// by freeing them individually.  The memory of those chunks can only be
+// reclaimed as a whole, which happens in 'swap' after all surviving
+// clauses have been moved to 'to' space by the moving garbage collector.
+// These clauses are marked as 'chunked', thus deleting them does not need
+// to search for their chunk.
+
 struct Internal;
 
 class Arena {
@@ -59,6 +69,14 @@ class Arena {
 
   struct { char * start, * top, * end; } from, to;
 
+  // The current chunk for bump allocation.  Each chunk starts with a
+  // header holding the start and the end of the previous chunk.
+  //
+  struct { char * start, * top, * end; } learned;
+
+  void grow (size_t bytes);     // Allocate new 'learned' chunk.
+  void release ();              // Delete all 'learned' chunks.
+
 public:
 
   Arena (Internal *);
@@ -78,6 +96,23 @@ public:
     return from.start <= c && c < from.top;
   }
 
+  // Is there any memory allocated with 'allocate' not released yet?
+  //
+  bool allocated () const { return learned.start; }
+
+  // Bump allocate that amount of memory in the current 'learned' chunk,
+  // which is enlarged if necessary.  This memory remains valid until the
+  // next 'swap'.  Thus clauses allocated here have to be copied to 'to'
+  // space by the moving garbage collector before calling 'swap'.
+  //
+  char * allocate (size_t bytes) {
+    if ((size_t) (learned.end - learned.top) < bytes) grow (bytes);
+    char * res = learned.top;
+    learned.top += bytes;
+    assert (learned.top <= learned.end);
+    return res;
+  }
+
   // Allocate that amount of memory in 'to' space.  This assumes the 'to'
   // space has been prepared to hold enough memory with 'prepare'.  Then
   // copy the memory pointed to by 'p' of size 'bytes'.  Note that it does
@@ -92,8 +127,9 @@ public:
   }
 
   // Completely delete 'from' space and then replace 'from' by 'to' (by
-  // pointer swapping).  Everything previously allocated (in 'from') and not
-  // explicitly copied to 'to' with 'copy' becomes invalid.
+  // pointer swapping).  Everything previously allocated (in 'from' or in
+  // 'learned' chunks) and not explicitly copied to 'to' with 'copy'
+  // becomes invalid.
   //
   void swap ();
 };
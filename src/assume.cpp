@@ -18,6 +18,46 @@ void Internal::assume (int lit) {
   freeze (lit);
 }
 
+// Consecutive incremental 'solve' calls often only differ in the last few
+// assumptions.  Since the previous call leaves the trail intact, we keep
+// those leading decision levels which would be decided and propagated in
+// exactly the same way for the new assumptions, similar to 'reuse_trail'
+// during restarts, and only backtrack to the first differing assumption.
+// Pseudo decision levels of already satisfied assumptions are kept too as
+// long as the assumption is still implied by the lower levels.  Returns
+// the number of kept levels (zero if the caller has to backtrack to the
+// root level and propagate there).
+
+int Internal::reuse_assumptions () {
+  if (!level) return 0;
+  if (!opts.assumereuse) return 0;
+  if (unsat || unsat_constraint) return 0;
+  if (assumptions.empty ()) return 0;
+  stats.assumptions.solves++;
+  const int size = assumptions.size ();
+  int res = 0;
+  while (res < level && res < size) {
+    const int lit = assumptions[res];
+    const int decision = control[res + 1].decision;
+    if (decision) {
+      if (decision != lit) break;
+    } else if (val (lit) <= 0 || var (lit).level > res) break;
+    res++;
+  }
+  if (!res) return 0;
+  backtrack (res);
+  if (!propagate ()) {
+    LOG ("propagating reused assumption levels produces conflict");
+    conflict = 0;
+    backtrack ();
+    return 0;
+  }
+  LOG ("reusing %d assumption levels", res);
+  stats.assumptions.reused++;
+  stats.assumptions.levels += res;
+  return res;
+}
+
 // Find all failing assumptions starting from the one on the assumption
 // stack with the lowest decision level.  This goes back to MiniSAT and is
 // called 'analyze_final' there.
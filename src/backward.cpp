@@ -11,18 +11,18 @@ namespace CaDiCaL {
 
 void Eliminator::enqueue (Clause * c) {
   if (!internal->opts.elimbackward) return;
-  if (c->enqueued) return;
+  if (internal->cold (c).enqueued) return;
   LOG (c, "backward enqueue");
   backward.push (c);
-  c->enqueued = true;
+  internal->cold (c).enqueued = true;
 }
 
 Clause * Eliminator::dequeue () {
   if (backward.empty ()) return 0;
   Clause * res = backward.front ();
   backward.pop ();
-  assert (res->enqueued);
-  res->enqueued = false;
+  assert (internal->cold (res).enqueued);
+  internal->cold (res).enqueued = false;
   LOG (res, "backward dequeue");
   return res;
 }
@@ -5,6 +5,14 @@
 #include "internal.hpp"
 #include "signal.hpp"           // Separate, only need for apps.
 
+#ifndef NTHREADS
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
 /*------------------------------------------------------------------------*/
 
 namespace CaDiCaL {
@@ -21,6 +29,214 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
+#ifndef NTHREADS
+
+// Learned clauses are shared between portfolio workers through single
+// producer single consumer ring buffers, one for each ordered pair of
+// workers.  A clause is stored as its glue followed by its literals and a
+// terminating zero.  If the ring is full the clause is simply dropped.
+
+class ClauseRing {
+
+  static const size_t capacity = 1u << 12;      // Power of two.
+  static const size_t mask = capacity - 1;
+
+  int data[capacity];
+  std::atomic<size_t> head;     // Written by the consumer only.
+  std::atomic<size_t> tail;     // Written by the producer only.
+
+public:
+
+  ClauseRing () : head (0), tail (0) { }
+
+  void push (const vector<int> & clause, int glue) {
+    const size_t t = tail.load (std::memory_order_relaxed);
+    const size_t h = head.load (std::memory_order_acquire);
+    if (t - h + clause.size () + 2 > capacity) return;
+    size_t p = t;
+    data[p++ & mask] = glue;
+    for (const auto & lit : clause)
+      data[p++ & mask] = lit;
+    data[p++ & mask] = 0;
+    tail.store (p, std::memory_order_release);
+  }
+
+  bool pop (vector<int> & clause, int & glue) {
+    size_t h = head.load (std::memory_order_relaxed);
+    const size_t t = tail.load (std::memory_order_acquire);
+    if (h == t) return false;
+    glue = data[h++ & mask];
+    int lit;
+    while ((lit = data[h++ & mask]))
+      clause.push_back (lit);
+    head.store (h, std::memory_order_release);
+    return true;
+  }
+};
+
+// In portfolio mode ('--threads=<n>') each worker runs a diversified copy
+// of the parsed formula in its own thread.  The first worker to find a
+// result stops all others through this terminator.  It also observes the
+// asynchronous time limit of the app.  Unless proofs are traced, workers
+// further export learned units and binary clauses to all other workers
+// and import theirs during restarts.
+
+struct Worker : public Terminator, public Learner, public ClauseSource {
+
+  Solver * solver;
+  FILE * proof;                 // Temporary proof file (if tracing).
+  int res;
+
+  std::atomic<bool> * stop;     // Set by the winning worker.
+  volatile bool * timesup;      // Set by the alarm handler of the app.
+
+  int id, workers;              // Index of this worker and their number.
+  ClauseRing * rings;           // Ring 'i*workers+j' from 'i' to 'j'.
+  vector<int> learned;          // Clause currently exported.
+  int next;                     // Round-robin index of importing ring.
+
+  Worker () :
+    solver (0), proof (0), res (0), stop (0), timesup (0),
+    id (0), workers (0), rings (0), next (0)
+  { }
+
+  bool terminate () {
+    return *timesup || stop->load (std::memory_order_relaxed);
+  }
+
+  bool learning (int size) { return size <= 2; }
+
+  void learn (int lit) {
+    if (lit) { learned.push_back (lit); return; }
+    const int glue = learned.size ();
+    for (int j = 0; j < workers; j++)
+      if (j != id) rings[id*workers + j].push (learned, glue);
+    learned.clear ();
+  }
+
+  bool import (vector<int> & clause, int & glue) {
+    for (int k = 0; k < workers; k++) {
+      const int j = next++;
+      if (next == workers) next = 0;
+      if (j == id) continue;
+      if (rings[j*workers + id].pop (clause, glue)) return true;
+    }
+    return false;
+  }
+
+  void share (int i, int n, ClauseRing * r) {
+    id = i, workers = n, rings = r;
+    solver->connect_learner (this);
+    solver->connect_clause_source (this);
+  }
+
+  void unshare () {
+    solver->disconnect_learner ();
+    solver->disconnect_clause_source ();
+  }
+};
+
+// In cube-and-conquer mode cubes are distributed over one double ended
+// queue per worker.  Workers take cubes from the back of their own queue
+// and steal cubes from the front of the queues of other workers as soon
+// as their own queue runs empty.  Cubes split by a worker are pushed to
+// the back of its own queue and thus solved by that worker first.
+
+struct CubeQueue {
+
+  std::mutex lock;
+  std::deque<vector<int>> cubes;
+
+  void push (vector<int> & cube) {
+    std::lock_guard<std::mutex> guard (lock);
+    cubes.push_back (std::move (cube));
+  }
+
+  bool take (vector<int> & cube, bool own) {
+    std::lock_guard<std::mutex> guard (lock);
+    if (cubes.empty ()) return false;
+    if (own) cube = std::move (cubes.back ()), cubes.pop_back ();
+    else cube = std::move (cubes.front ()), cubes.pop_front ();
+    return true;
+  }
+};
+
+// Workers without cubes to take or steal wait until cubes are pushed, a
+// cube was solved (which might conclude solving) or cube generation ended.
+// The number of signaled changes is read before looking for cubes.  If it
+// is still the same afterwards the worker sleeps until the next change.
+
+struct CubeSignal {
+
+  std::mutex lock;
+  std::condition_variable changed;
+  int64_t changes;
+
+  CubeSignal () : changes (0) { }
+
+  int64_t current () {
+    std::lock_guard<std::mutex> guard (lock);
+    return changes;
+  }
+
+  void signal () {
+    {
+      std::lock_guard<std::mutex> guard (lock);
+      changes++;
+    }
+    changed.notify_all ();
+  }
+
+  void wait (int64_t seen) {
+    std::unique_lock<std::mutex> guard (lock);
+    changed.wait (guard, [&] { return changes != seen; });
+  }
+};
+
+// Generated cubes are distributed round-robin over the cube queues while
+// the workers are already solving them.
+
+struct CubeDistributor : public CubeSink {
+
+  vector<CubeQueue> & queues;
+  CubeSignal & signal;
+  std::atomic<int64_t> & pending;
+  std::atomic<bool> & stop;
+  int64_t cubes;
+
+  CubeDistributor (vector<CubeQueue> & q, CubeSignal & c,
+                   std::atomic<int64_t> & p, std::atomic<bool> & s) :
+    queues (q), signal (c), pending (p), stop (s), cubes (0) { }
+
+  bool cube (const vector<int> & c) {
+    vector<int> copy = c;
+    pending++;
+    queues[cubes++ % queues.size ()].push (copy);
+    signal.signal ();
+    return !stop;
+  }
+};
+
+#endif
+
+// Without threads generated cubes are stored in the same format as the
+// cubes of 'p inccnf' files, i.e., as zero terminated literal sequences.
+
+struct CubeAppender : public CubeSink {
+  vector<int> & literals;
+  size_t cubes;
+  CubeAppender (vector<int> & l) : literals (l), cubes (0) { }
+  bool cube (const vector<int> & c) {
+    for (const auto & lit : c)
+      literals.push_back (lit);
+    literals.push_back (0);
+    cubes++;
+    return true;
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
 class App : public Handler, public Terminator {
 
   Solver * solver;                // Global solver.
@@ -44,6 +260,21 @@ class App : public Handler, public Terminator {
 
   bool force_writing;
   static bool most_likely_existing_cnf_file (const char * path);
+  static bool binary_cnf_file (const char * path);
+
+#ifndef NTHREADS
+  int threads;                  // '--threads=<n>'
+  int split_limit;              // '--split=<conflicts>'
+  FILE * portfolio_proof;       // Proof trace of the winning worker.
+  void diversify (Solver *, int worker);
+  int portfolio (bool proof_specified,
+                 int preprocessing, int localsearch,
+                 int conflict_limit, int decision_limit);
+  void copy_portfolio_proof (const char * proof_path);
+  int conquer (const vector<int> & cube_literals, int cube_depth,
+               int preprocessing, int localsearch,
+               int conflict_limit, int decision_limit);
+#endif
 
   // Internal variables.
   //
@@ -131,6 +362,13 @@ void App::print_usage (bool all) {
 "  -t <sec>       set wall clock time limit\n"
 #endif
 "\n"
+"  --cubes=<d>    generate cubes by lookahead up to depth '<d>' and solve them\n"
+#ifndef NTHREADS
+"  --threads=<n>  race '<n>' diversified solver copies in parallel\n"
+"                (or solve cubes in parallel if there are any)\n"
+"  --split=<c>    split parallel cubes open after '<c>' conflicts\n"
+#endif
+"\n"
 "Or '<option>' is one of the less common options\n"
 "\n"
 "  -L<rounds>     run local search initially (default '0' rounds)\n"
@@ -144,6 +382,7 @@ void App::print_usage (bool all) {
 "  -d <limit>     limit the number of decisions (default unlimited)\n"
 "\n"
 "  -o <output>    write simplified CNF in DIMACS format to file\n"
+"                 (in binary CNF format if the file has a '.bcnf' suffix)\n"
 "  -e <extend>    write reconstruction/extension stack to file\n"
 #ifdef LOGGING
 "  -l             enable logging messages (same as '--log')\n"
@@ -231,7 +470,10 @@ void App::print_usage (bool all) {
 "\n"
 "By default the proof is stored in the binary DRAT format unless\n"
 "the option '--no-binary' is specified or the proof is written\n"
-"to  '<stdout>' and '<stdout>' is connected to a terminal.\n"
+"to  '<stdout>' and '<stdout>' is connected to a terminal.  With\n"
+"'--lrat' the proof is written in the LRAT format instead, where the\n"
+"clauses of the input file are numbered in order starting with one\n"
+"(which is not supported in combination with '--threads').\n"
 "\n"
 "The input is assumed to be compressed if it is given explicitly\n"
 "and has a '.gz', '.bz2', '.xz' or '.7z' suffix.  The same applies\n"
@@ -292,6 +534,18 @@ bool App::most_likely_existing_cnf_file (const char * path)
   if (has_suffix (path, ".cnf.7z")) return true;
   if (has_suffix (path, ".cnf.lzma")) return true;
 
+  return binary_cnf_file (path);
+}
+
+bool App::binary_cnf_file (const char * path)
+{
+  if (has_suffix (path, ".bcnf")) return true;
+  if (has_suffix (path, ".bcnf.gz")) return true;
+  if (has_suffix (path, ".bcnf.xz")) return true;
+  if (has_suffix (path, ".bcnf.bz2")) return true;
+  if (has_suffix (path, ".bcnf.7z")) return true;
+  if (has_suffix (path, ".bcnf.lzma")) return true;
+
   return false;
 }
 
@@ -304,6 +558,313 @@ do { solver->error (__VA_ARGS__); } while (0)
 
 /*------------------------------------------------------------------------*/
 
+#ifndef NTHREADS
+
+// Worker '0' uses the options as given.  The others use different
+// pre-defined configurations, initial phases and random seeds.  Note that
+// diversification happens before copying the parsed solver into the
+// worker, and 'Solver::copy' only overwrites options which were explicitly
+// set to non-default values by the user.
+
+void App::diversify (Solver * worker, int i) {
+  static const char * configurations[] = { "default", "sat", "unsat" };
+  const int n = sizeof configurations / sizeof *configurations;
+  worker->configure (configurations[i % n]);
+  if ((i / n) & 1) worker->set ("phase", 0);
+  if (i >= 2*n) worker->set ("shuffle", 1), worker->set ("shufflerandom", 1);
+  worker->set ("seed", i);
+}
+
+// Race diversified copies of the parsed solver until the first one
+// produces a result.  Afterwards the winner replaces 'solver', so that
+// witness, statistics and all other output are taken from the winner.
+
+int App::portfolio (bool proof_specified,
+                    int preprocessing, int localsearch,
+                    int conflict_limit, int decision_limit) {
+
+  solver->section ("portfolio");
+  solver->message ("racing %d diversified solver copies", threads);
+
+#ifndef QUIET
+  const int quiet = get ("quiet");
+#endif
+  const int binary = get ("binary");
+
+  std::atomic<bool> stop (false);
+  std::atomic<int> winner (-1);
+  vector<Worker> workers (threads);
+  vector<ClauseRing> rings (proof_specified ? 0 : threads * threads);
+
+  for (int i = 0; i < threads; i++) {
+    Worker & worker = workers[i];
+    worker.stop = &stop;
+    worker.timesup = &timesup;
+    worker.solver = new Solver ();
+    diversify (worker.solver, i);
+    if (proof_specified) {
+      worker.proof = tmpfile ();
+      if (!worker.proof)
+        APPERR ("can not open temporary proof file for worker %d", i);
+      worker.solver->set ("binary", binary);
+      worker.solver->trace_proof (worker.proof, "<portfolio>");
+    }
+    solver->copy (*worker.solver);
+#ifndef QUIET
+    worker.solver->set ("quiet", 1);
+#endif
+    if (preprocessing > 0)
+      worker.solver->limit ("preprocessing", preprocessing);
+    if (localsearch > 0)
+      worker.solver->limit ("localsearch", localsearch);
+    if (conflict_limit >= 0)
+      worker.solver->limit ("conflicts", conflict_limit);
+    if (decision_limit >= 0)
+      worker.solver->limit ("decisions", decision_limit);
+    worker.solver->connect_terminator (&worker);
+    if (!proof_specified) worker.share (i, threads, rings.data ());
+  }
+
+  vector<std::thread> running;
+  for (int i = 0; i < threads; i++)
+    running.push_back (std::thread ([&workers, &stop, &winner, i] () {
+      Worker & worker = workers[i];
+      worker.res = worker.solver->solve ();
+      if (!worker.res) return;
+      int expected = -1;
+      if (winner.compare_exchange_strong (expected, i))
+        stop = true;
+    }));
+
+  for (auto & thread : running)
+    thread.join ();
+
+  int res, best = winner;
+  if (best < 0) {
+    solver->message ("no worker produced a result");
+    best = 0, res = 0;
+  } else {
+    res = workers[best].res;
+    solver->message ("worker %d won with result %d", best, res);
+  }
+
+  for (int i = 0; i < threads; i++) {
+    Worker & worker = workers[i];
+    worker.solver->disconnect_terminator ();
+    if (!proof_specified) worker.unshare ();
+    if (i == best) continue;
+    delete worker.solver;
+    if (worker.proof) fclose (worker.proof);
+  }
+
+  delete solver;
+  solver = workers[best].solver;
+  portfolio_proof = workers[best].proof;
+#ifndef QUIET
+  set ("quiet", quiet);
+#endif
+
+  return res;
+}
+
+// The winning worker traced its proof to a temporary file, which is
+// finally copied to the actual proof file (or '<stdout>').
+
+void App::copy_portfolio_proof (const char * proof_path) {
+  assert (portfolio_proof);
+  FILE * file = proof_path ? fopen (proof_path, "w") : stdout;
+  if (!file)
+    APPERR ("can not open and write DRAT proof to '%s'", proof_path);
+  rewind (portfolio_proof);
+  char buffer[1<<16];
+  size_t bytes;
+  while ((bytes = fread (buffer, 1, sizeof buffer, portfolio_proof)))
+    if (fwrite (buffer, 1, bytes, file) != bytes)
+      APPERR ("writing DRAT proof failed");
+  if (proof_path) fclose (file);
+  else fflush (file);
+  fclose (portfolio_proof);
+  portfolio_proof = 0;
+}
+
+// Solve cubes (from 'p inccnf' input or generated by '--cubes=<depth>')
+// in parallel by a pool of workers, each a copy of the parsed solver
+// solving cubes under assumptions.  Cubes are generated by the calling
+// thread while the workers already solve the first generated cubes.
+// Cubes which are still open after '--split=<conflicts>' conflicts are
+// split on a lookahead literal and the two resulting cubes are put back
+// into the queue of the worker.  The first satisfiable cube stops all
+// workers and its worker replaces 'solver' in order to print the witness.
+// For unsatisfiable cubes the clause of negated failed assumptions is
+// added to the worker (and the formula is unsatisfiable if there are no
+// failed assumptions).
+
+int App::conquer (const vector<int> & cube_literals, int cube_depth,
+                  int preprocessing, int localsearch,
+                  int conflict_limit, int decision_limit) {
+
+  solver->section ("cube and conquer");
+
+  vector<CubeQueue> queues (threads);
+  CubeSignal signal;
+  int64_t cubes = 0;
+  vector<int> cube;
+  for (const auto & lit : cube_literals) {
+    if (lit) { cube.push_back (lit); continue; }
+    queues[cubes++ % threads].push (cube);
+    cube.clear ();
+  }
+
+  if (cube_depth)
+    solver->message ("conquering cubes up to depth %d with %d workers",
+      cube_depth, threads);
+  else
+    solver->message ("conquering %" PRId64 " cubes with %d workers",
+      cubes, threads);
+
+#ifndef QUIET
+  const int quiet = get ("quiet");
+#endif
+  const bool splitting =
+    split_limit > 0 && conflict_limit < 0 && decision_limit < 0;
+
+  std::atomic<bool> stop (false), cubing (cube_depth > 0);
+  std::atomic<int> winner (-1);
+  std::atomic<int64_t> pending (cubes);
+  std::atomic<int64_t> unsatisfiable (0), inconclusive (0), split (0);
+  vector<Worker> workers (threads);
+  vector<ClauseRing> rings (threads * threads);
+
+  for (int i = 0; i < threads; i++) {
+    Worker & worker = workers[i];
+    worker.stop = &stop;
+    worker.timesup = &timesup;
+    worker.solver = new Solver ();
+    solver->copy (*worker.solver);
+#ifndef QUIET
+    worker.solver->set ("quiet", 1);
+#endif
+    if (preprocessing > 0)
+      worker.solver->limit ("preprocessing", preprocessing);
+    if (localsearch > 0)
+      worker.solver->limit ("localsearch", localsearch);
+    worker.solver->connect_terminator (&worker);
+    worker.share (i, threads, rings.data ());
+  }
+
+  vector<std::thread> running;
+  for (int i = 0; i < threads; i++)
+    running.push_back (std::thread ([&, i] () {
+      Worker & worker = workers[i];
+      Solver * s = worker.solver;
+      vector<int> cube;
+      while (!worker.terminate () && (cubing || pending > 0)) {
+        const int64_t seen = signal.current ();
+        bool taken = queues[i].take (cube, true);
+        for (int k = 1; !taken && k < threads; k++)
+          taken = queues[(i + k) % threads].take (cube, false);
+        if (!taken) {
+          signal.wait (seen);
+          continue;
+        }
+        for (const auto & lit : cube) s->assume (lit);
+        if (conflict_limit >= 0) s->limit ("conflicts", conflict_limit);
+        else if (splitting) s->limit ("conflicts", split_limit);
+        if (decision_limit >= 0) s->limit ("decisions", decision_limit);
+        int res = s->solve ();
+        if (!res && splitting && !worker.terminate ()) {
+          for (const auto & lit : cube) s->assume (lit);
+          const int lit = s->lookahead ();
+          s->reset_assumptions ();
+          if (lit) {
+            vector<int> other = cube;
+            cube.push_back (lit);
+            other.push_back (-lit);
+            pending += 2;
+            queues[i].push (cube);
+            queues[i].push (other);
+            split++;
+            pending--;
+            signal.signal ();
+            continue;
+          }
+          for (const auto & lit : cube) s->assume (lit);
+          res = s->solve ();
+        }
+        if (res == 10) {
+          worker.res = 10;
+          int expected = -1;
+          if (winner.compare_exchange_strong (expected, i))
+            stop = true;
+        } else if (res == 20) {
+          unsatisfiable++;
+          vector<int> failed;
+          for (const auto & lit : cube)
+            if (s->failed (lit))
+              failed.push_back (lit);
+          for (const auto & lit : failed)
+            s->add (-lit);
+          s->add (0);
+          if (failed.empty ()) {
+            worker.res = 20;
+            int expected = -1;
+            if (winner.compare_exchange_strong (expected, i))
+              stop = true;
+          }
+        } else inconclusive++;
+        pending--;
+        signal.signal ();
+      }
+    }));
+
+  if (cube_depth) {
+    CubeDistributor distributor (queues, signal, pending, stop);
+    const int status = solver->generate_cubes (cube_depth, distributor);
+    if (status || !distributor.cubes)
+      distributor.cube (vector<int> ());
+    cubing = false;
+    signal.signal ();
+    solver->message ("generated %" PRId64 " cubes", distributor.cubes);
+  }
+
+  for (auto & thread : running)
+    thread.join ();
+
+  solver->message ("%" PRId64 " cubes split", (int64_t) split);
+  solver->message ("%" PRId64 " cubes unsatisfiable",
+    (int64_t) unsatisfiable);
+  solver->message ("%" PRId64 " cubes inconclusive",
+    (int64_t) inconclusive);
+
+  int res = 0, best = winner;
+  if (best >= 0) {
+    res = workers[best].res;
+    solver->message ("worker %d concluded with result %d", best, res);
+  } else if (!pending && !inconclusive) res = 20;
+
+  for (int i = 0; i < threads; i++) {
+    Worker & worker = workers[i];
+    worker.solver->disconnect_terminator ();
+    worker.unshare ();
+    if (i == best) continue;
+    delete worker.solver;
+  }
+
+  if (best >= 0) {
+    delete solver;
+    solver = workers[best].solver;
+  }
+#ifndef QUIET
+  set ("quiet", quiet);
+#endif
+
+  return res;
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 int App::main (int argc, char ** argv) {
 
   // Handle options which lead to immediate exit first.
@@ -347,6 +908,12 @@ int App::main (int argc, char ** argv) {
   const char * localsearch_specified = 0;
 #ifndef __MINGW32__
   const char * time_limit_specified = 0;
+#endif
+  const char * cubes_specified = 0;
+  int cube_depth = 0;
+#ifndef NTHREADS
+  const char * threads_specified = 0;
+  const char * split_specified = 0;
 #endif
   bool witness = true, less = false;
   const char * dimacs_name, * err;
@@ -451,6 +1018,41 @@ int App::main (int argc, char ** argv) {
         APPERR ("invalid time limit");
       else time_limit_specified = argv[i];
     }
+#endif
+    else if (has_prefix (argv[i], "--cubes=")) {
+      if (cubes_specified)
+        APPERR ("multiple cube options '%s' and '%s'",
+          cubes_specified, argv[i]);
+      cubes_specified = argv[i];
+      if (!parse_int_str (argv[i] + 8, cube_depth))
+        APPERR ("invalid argument in '%s'", argv[i]);
+      if (cube_depth < 1)
+        APPERR ("invalid argument in '%s' (expected positive number)",
+          argv[i]);
+    }
+#ifndef NTHREADS
+    else if (has_prefix (argv[i], "--split=")) {
+      if (split_specified)
+        APPERR ("multiple split options '%s' and '%s'",
+          split_specified, argv[i]);
+      split_specified = argv[i];
+      if (!parse_int_str (argv[i] + 8, split_limit))
+        APPERR ("invalid argument in '%s'", argv[i]);
+      if (split_limit < 0)
+        APPERR ("invalid argument in '%s' (expected non-negative number)",
+          argv[i]);
+    }
+    else if (has_prefix (argv[i], "--threads=")) {
+      if (threads_specified)
+        APPERR ("multiple thread options '%s' and '%s'",
+          threads_specified, argv[i]);
+      threads_specified = argv[i];
+      if (!parse_int_str (argv[i] + 10, threads))
+        APPERR ("invalid argument in '%s'", argv[i]);
+      if (threads < 1)
+        APPERR ("invalid argument in '%s' (expected positive number)",
+          argv[i]);
+    }
 #endif
 #ifndef QUIET
     else if (!strcmp (argv[i], "-q")) set ("--quiet");
@@ -529,6 +1131,21 @@ int App::main (int argc, char ** argv) {
       !strcmp (dimacs_path, proof_path) && strcmp (dimacs_path, "-"))
     APPERR ("DIMACS input file '%s' also specified as DRAT proof file",
       dimacs_path);
+#ifndef NTHREADS
+  if (threads > 1 && proof_path &&
+      (has_suffix (proof_path, ".gz") ||
+       has_suffix (proof_path, ".bz2") ||
+       has_suffix (proof_path, ".xz") ||
+       has_suffix (proof_path, ".7z") ||
+       has_suffix (proof_path, ".lzma")))
+    APPERR ("can not compress DRAT proof file '%s' with '%s'",
+      proof_path, threads_specified);
+  if (threads > 1 && proof_specified && cubes_specified)
+    APPERR ("can not generate DRAT proof with '%s' and '%s'",
+      cubes_specified, threads_specified);
+  if (threads > 1 && proof_specified && get ("lrat"))
+    APPERR ("can not generate LRAT proof with '%s'", threads_specified);
+#endif
 
   /*----------------------------------------------------------------------*/
   // The '--less' option is not fully functional yet (it is also not
@@ -605,12 +1222,22 @@ int App::main (int argc, char ** argv) {
     }
   }
   if (verbose () || proof_specified) solver->section ("proof tracing");
+#ifndef NTHREADS
+  if (proof_specified && threads > 1) {
+    if (!proof_path && isatty (1) && get ("binary")) set ("--no-binary");
+    solver->message ("writing %s proof trace of winning worker to %s'%s'%s",
+      (get ("binary") ? "binary" : "non-binary"),
+      tout.green_code (), proof_path ? proof_path : "<stdout>",
+      tout.normal_code ());
+  } else
+#endif
   if (proof_specified) {
     if (!proof_path) {
       const bool force_binary = (isatty (1) && get ("binary"));
       if (force_binary) set ("--no-binary");
-      solver->message ("writing %s proof trace to %s'<stdout>'%s",
+      solver->message ("writing %s %s proof trace to %s'<stdout>'%s",
         (get ("binary") ? "binary" : "non-binary"),
+        (get ("lrat") ? "LRAT" : "DRAT"),
         tout.green_code (), tout.normal_code ());
       if (force_binary)
         solver->message (
@@ -620,8 +1247,9 @@ int App::main (int argc, char ** argv) {
       APPERR ("can not open and write DRAT proof to '%s'", proof_path);
     else
       solver->message (
-        "writing %s proof trace to %s'%s'%s",
+        "writing %s %s proof trace to %s'%s'%s",
         (get ("binary") ? "binary" : "non-binary"),
+        (get ("lrat") ? "LRAT" : "DRAT"),
         tout.green_code (), proof_path, tout.normal_code ());
   } else solver->verbose (1, "will not generate nor write DRAT proof");
   solver->section ("parsing input");
@@ -660,6 +1288,37 @@ int App::main (int argc, char ** argv) {
 
   int res = 0;
 
+  if (cube_depth) {
+    if (incremental)
+      APPERR ("can not use '%s' for incremental 'p inccnf' input",
+        cubes_specified);
+#ifndef NTHREADS
+    if (threads == 1)
+#endif
+    {
+      solver->section ("cubing");
+      CubeAppender appender (cube_literals);
+      const int status = solver->generate_cubes (cube_depth, appender);
+      if (status || !appender.cubes) {
+        cube_literals.clear ();
+        appender.cubes = 0;
+        appender.cube (vector<int> ());
+      }
+      solver->message ("generated %zu cubes up to depth %d",
+        appender.cubes, cube_depth);
+    }
+    incremental = true;
+  }
+
+#ifndef NTHREADS
+  if (incremental && threads > 1) {
+    if (proof_specified)
+      APPERR ("can not generate DRAT proof with '%s' for 'p inccnf' input",
+        threads_specified);
+    res = conquer (cube_literals, cube_depth, preprocessing, localsearch,
+                   conflict_limit, decision_limit);
+  } else
+#endif
   if (incremental) {
     bool reporting = get ("report") > 1 || get ("verbose") > 0;
     if (!reporting) set ("report", 0);
@@ -777,7 +1436,13 @@ int App::main (int argc, char ** argv) {
 
     if (inconclusive && res == 20)
       res = 0;
-  } else {
+  }
+#ifndef NTHREADS
+  else if (threads > 1)
+    res = portfolio (proof_specified, preprocessing, localsearch,
+                     conflict_limit, decision_limit);
+#endif
+  else {
     solver->section ("solving");
     res = solver->solve ();
   }
@@ -786,13 +1451,18 @@ int App::main (int argc, char ** argv) {
     solver->section ("closing proof");
     solver->flush_proof_trace ();
     solver->close_proof_trace ();
+#ifndef NTHREADS
+    if (portfolio_proof) copy_portfolio_proof (proof_path);
+#endif
   }
 
   if (output_path) {
+    const bool binary = binary_cnf_file (output_path);
     solver->section ("writing output");
-    solver->message ("writing simplified CNF to DIMACS file %s'%s'%s",
+    solver->message ("writing simplified CNF to %s file %s'%s'%s",
+      binary ? "binary CNF" : "DIMACS",
       tout.green_code (), output_path, tout.normal_code ());
-    err = solver->write_dimacs (output_path, max_var);
+    err = solver->write_dimacs (output_path, max_var, binary);
     if (err) APPERR ("%s", err);
   }
 
@@ -853,6 +1523,11 @@ void App::init () {
 #endif
   force_strict_parsing = 1;
   force_writing = false;
+#ifndef NTHREADS
+  threads = 1;
+  split_limit = 10000;
+  portfolio_proof = 0;
+#endif
   max_var = 0;
   timesup = false;
 
@@ -192,7 +192,10 @@ struct External;
 
 // Forward declaration of call-back classes. See bottom of this file.
 
+class ClauseSource;
+class CubeSink;
 class Learner;
+class ResultSink;
 class Terminator;
 class ClauseIterator;
 class WitnessIterator;
@@ -286,6 +289,35 @@ public:
 
   // ====== END IPASIR =====================================================
 
+  //------------------------------------------------------------------------
+  // Bulk versions of 'add'.  The first adds the 'size' literals in 'lits'
+  // exactly as if 'add' was called on each of them, i.e., 'lits' holds zero
+  // terminated clauses and only the last clause may be left open.  The
+  // second adds the single clause of 'size' non-zero literals in 'lits'
+  // (without terminating zero) and then terminates it.  Literals are
+  // checked and new variables reserved once for the whole buffer, which
+  // avoids most of the per-literal overhead of calling 'add' repeatedly.
+  //
+  //   require (VALID)
+  //   if (size && lits[size-1]) ensure (ADDING)   // only 'add_clauses'
+  //   else if (size) ensure (UNKNOWN)
+  //
+  void add_clauses (const int * lits, size_t size);
+  void add_clause (const int * lits, size_t size);
+  void add_clause (const std::vector<int> & clause);
+
+  //------------------------------------------------------------------------
+  // Add call-back which allows to import clauses, for instance learned by
+  // other solvers working on the same formula (see 'ClauseSource' below).
+  // There can only be one clause source connected.  Connecting a second
+  // (non-zero) one implicitly disconnects the first one.
+  //
+  //   require (VALID)
+  //   ensure (VALID)
+  //
+  void connect_clause_source (ClauseSource * source);
+  void disconnect_clause_source ();
+
   //------------------------------------------------------------------------
   // Adds a literal to the constraint clause. Same functionality as 'add' but
   // the clause only exists for the next call to solve (same lifetime as
@@ -317,7 +349,7 @@ public:
   // the function is not able to determine satisfiability also zero is
   // returned but the state remains unknown.
   //
-  //   require (READY)
+  //   require (VALID | SOLVING)
   //   ensure (UNKNOWN|SATISFIED|UNSATISFIED)
   //
   int lookahead(void);
@@ -329,6 +361,33 @@ public:
 
   CubesWithStatus generate_cubes(int, int min_depth = 0);
 
+  // Streaming version of 'generate_cubes', which explores the cube tree
+  // depth-first and passes each cube to the sink as soon as it is final,
+  // instead of collecting all cubes first.  Thus memory usage only depends
+  // on the depth and cubes can be solved while cubes are still generated.
+  // Returns the status (10, 20 or zero if unknown).
+  //
+  //   require (VALID | SOLVING)
+  //   ensure (UNKNOWN|SATISFIED|UNSATISFIED)
+  //
+  int generate_cubes (int depth, CubeSink & sink, int min_depth = 0);
+
+  // Solve the formula under each of the given (independent) assumption
+  // sets in turn and pass the results to the sink.  Queries are reordered
+  // such that queries sharing assumption prefixes are solved one after the
+  // other, which allows to keep these prefixes on the trail.  Literals
+  // within a query might be reordered too.  The sink is called right after
+  // each query is solved, thus still in the state of the query, and might
+  // query 'val' or 'failed' itself.  Solving stops early if the sink
+  // returns false or a query remains unsolved (due to 'terminate' or
+  // limits).  Returns the number of queries passed to the sink.
+  //
+  //   require (READY)
+  //   ensure (UNKNOWN | SATISFIED | UNSATISFIED)
+  //
+  size_t solve_batch (const std::vector<std::vector<int>> & queries,
+                      ResultSink & sink);
+
   void reset_assumptions ();
   void reset_constraint ();
 
@@ -658,6 +717,9 @@ public:
   // strict formatting of the header is required, i.e., single spaces
   // everywhere and no trailing white space.
   //
+  // Files in the compact binary CNF format written by 'write_dimacs' with
+  // 'binary' set are recognized by their magic number and parsed too.
+  //
   // Returns zero if successful and otherwise an error message.
   //
   //   require (VALID)
@@ -689,12 +751,16 @@ public:
   // The 'min_max_var' parameter gives a lower bound on the number '<vars>'
   // of variables used in the DIMACS 'p cnf <vars> ...' header.
   //
+  // If 'binary' is true a compact binary CNF format is written instead,
+  // which is much faster to write and to read back with 'read_dimacs'.
+  //
   // Returns zero if successful and otherwise an error message.
   //
   //   require (VALID)
   //   ensure (VALID)
   //
-  const char * write_dimacs (const char * path, int min_max_var = 0);
+  const char * write_dimacs (const char * path, int min_max_var = 0,
+                             bool binary = false);
 
   // The extension stack for reconstruction a solution can be written too.
   //
@@ -890,6 +956,22 @@ public:
   virtual void learn (int lit) = 0;
 };
 
+// Connected clause sources are polled by the solver during restarts to
+// import clauses.  If 'import' returns true it has filled 'clause' (given
+// empty) with the (external) literals of the next clause and 'glue' with
+// its glue.  Imported clauses have to be implied by the formula of the
+// solver, e.g., learned by another solver on the same formula, and are
+// added as redundant clauses.  Clauses over variables unknown or not active
+// (eliminated or substituted) in this solver are ignored, and so are all
+// clauses if proof tracing or checking is enabled.  The 'import' function
+// is called from the thread running the solver.
+
+class ClauseSource {
+public:
+  virtual ~ClauseSource () { }
+  virtual bool import (std::vector<int> & clause, int & glue) = 0;
+};
+
 /*------------------------------------------------------------------------*/
 
 // Allows to traverse all remaining irredundant clauses.  Satisfied and
@@ -907,6 +989,33 @@ public:
 
 /*------------------------------------------------------------------------*/
 
+// Receives the cubes generated by the streaming version of
+// 'generate_cubes' one by one.  Cube generation stops if 'cube' returns
+// false.
+
+class CubeSink {
+public:
+  virtual ~CubeSink () { }
+  virtual bool cube (const std::vector<int> &) = 0;
+};
+
+/*------------------------------------------------------------------------*/
+
+// Receives the results of 'solve_batch' one query at a time.  The 'query'
+// argument is the index of the assumption set in the batch, 'status' the
+// result of solving it (10, 20 or zero) and 'failed' contains the failed
+// assumptions of the query if it is unsatisfiable (and is empty otherwise).
+// If 'result' returns false the remaining queries are skipped.
+
+class ResultSink {
+public:
+  virtual ~ResultSink () { }
+  virtual bool result (size_t query, int status,
+                       const std::vector<int> & failed) = 0;
+};
+
+/*------------------------------------------------------------------------*/
+
 // Allows to traverse all clauses on the extension stack together with their
 // witness cubes.  If the solver is inconsistent, i.e., an empty clause is
 // found and the formula is unsatisfiable, then nothing is traversed.
@@ -105,6 +105,16 @@ void ccadical_add (CCaDiCaL * wrapper, int lit) {
   ((Wrapper*) wrapper)->solver->add (lit);
 }
 
+void ccadical_add_clauses (CCaDiCaL * wrapper,
+                           const int * lits, size_t size) {
+  ((Wrapper*) wrapper)->solver->add_clauses (lits, size);
+}
+
+void ccadical_add_clause (CCaDiCaL * wrapper,
+                          const int * lits, size_t size) {
+  ((Wrapper*) wrapper)->solver->add_clause (lits, size);
+}
+
 void ccadical_assume (CCaDiCaL * wrapper, int lit) {
   ((Wrapper*) wrapper)->solver->assume (lit);
 }
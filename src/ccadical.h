@@ -7,6 +7,7 @@ extern "C" {
 #endif
 /*------------------------------------------------------------------------*/
 
+#include <stddef.h>
 #include <stdint.h>
 
 // C wrapper for CaDiCaL's C++ API following IPASIR.
@@ -33,6 +34,8 @@ void ccadical_set_learn (CCaDiCaL *,
 
 // Non-IPASIR conformant 'C' functions.
 
+void ccadical_add_clauses (CCaDiCaL *, const int * lits, size_t size);
+void ccadical_add_clause (CCaDiCaL *, const int * lits, size_t size);
 void ccadical_constrain (CCaDiCaL *, int lit);
 int ccadical_constraint_failed (CCaDiCaL *);
 void ccadical_set_option (CCaDiCaL *, const char * name, int val);
@@ -75,6 +75,9 @@ Clause * Internal::new_clause (bool red, int glue) {
   assert (size >= 2);
 
   if (glue > size) glue = size;
+#ifdef COLDFLAGS
+  if (glue > Clause::max_glue) glue = Clause::max_glue;
+#endif
 
   // Determine whether this clauses should be kept all the time.
   //
@@ -83,30 +86,44 @@ Clause * Internal::new_clause (bool red, int glue) {
   else if (glue <= opts.reducetier1glue) keep = true;
   else keep = false;
 
+  // Redundant clauses are bump allocated in the arena if enabled (see
+  // 'arena.hpp').  Their memory is only reclaimed during garbage collection
+  // after the surviving clauses have been moved.
+  //
   size_t bytes = Clause::bytes (size);
-  Clause * c = (Clause *) new char[bytes];
+  const bool chunked = red && opts.arenalearn && arenaing ();
+  Clause * c;
+  if (chunked) c = (Clause *) arena.allocate (bytes);
+  else c = (Clause *) new char[bytes];
 
   stats.added.total++;
 #ifdef LOGGING
   c->id = stats.added.total;
 #endif
 
-  c->conditioned = false;
-  c->covered = false;
-  c->enqueued = false;
-  c->frozen = false;
+#ifdef COLDFLAGS
+  assert (colds.size () < UINT_MAX);
+  c->cold = colds.size ();
+  colds.push_back (ColdFlags ());
+#endif
+
+  c->chunked = chunked;
+  cold (c).conditioned = false;
+  cold (c).covered = false;
+  cold (c).enqueued = false;
+  cold (c).frozen = false;
   c->garbage = false;
-  c->gate = false;
+  cold (c).gate = false;
   c->hyper = false;
-  c->instantiated = false;
+  cold (c).instantiated = false;
   c->keep = keep;
   c->moved = false;
   c->reason = false;
   c->redundant = red;
-  c->transred = false;
-  c->subsume = false;
-  c->vivified = false;
-  c->vivify = false;
+  cold (c).transred = false;
+  cold (c).subsume = false;
+  cold (c).vivified = false;
+  cold (c).vivify = false;
   c->used = 0;
 
   c->glue = glue;
@@ -205,12 +222,12 @@ size_t Internal::shrink_clause (Clause * c, int new_size) {
 }
 
 // This is the 'raw' deallocation of a clause.  If the clause is in the
-// arena nothing happens.  If the clause is not in the arena its memory is
-// reclaimed immediately.
+// arena (or was bump allocated there) nothing happens.  If the clause is
+// not in the arena its memory is reclaimed immediately.
 
 void Internal::deallocate_clause (Clause * c) {
   char * p = (char*) c;
-  if (arena.contains (p)) return;
+  if (c->chunked || arena.contains (p)) return;
   LOG (c, "deallocate pointer %p", (void*) c);
   delete [] p;
 }
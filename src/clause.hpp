@@ -21,29 +21,46 @@ typedef const int * const_literal_iterator;
 // to store the actual literals somewhere else, which not only needs more
 // memory but more importantly also requires another memory access and thus
 // is very costly.
+//
+// The flags only used by inprocessing procedures are 'cold' and gathered
+// in 'ColdFlags'.  By default they are kept in the clause header too.  If
+// compiled with '-DCOLDFLAGS' (configure option '--cold-flags') they are
+// moved to a side table 'Internal::colds' indexed by the 'cold' field of
+// the clause instead.  Then propagation, conflict analysis and 'reduce'
+// only touch the remaining 'hot' part of the header and more cold flags
+// can be added without growing clauses.  Always access cold flags through
+// 'Internal::cold (Clause *)', which hides this difference.
+
+struct ColdFlags {
+  bool conditioned:1; // Tried for globally blocked clause elimination.
+  bool covered:1;     // Already considered for covered clause elimination.
+  bool enqueued:1;    // Enqueued on backward queue.
+  bool frozen:1;      // Temporarily frozen (in covered clause elimination).
+  bool gate:1 ;       // Clause part of a gate (function definition).
+  bool instantiated:1;// tried to instantiate
+  bool transred:1;    // already checked for transitive reduction
+  bool subsume:1;     // not checked in last subsumption round
+  bool vivified:1;    // clause already vivified
+  bool vivify:1;      // clause scheduled to be vivified
+};
 
 struct Clause {
 #ifdef LOGGING
   int64_t id;         // Only useful for debugging.
 #endif
 
-  bool conditioned:1; // Tried for globally blocked clause elimination.
-  bool covered:1;     // Already considered for covered clause elimination.
-  bool enqueued:1;    // Enqueued on backward queue.
-  bool frozen:1;      // Temporarily frozen (in covered clause elimination).
+#ifndef COLDFLAGS
+  ColdFlags cold;     // Flags only used during inprocessing.
+#endif
+
+  bool chunked:1;     // bump allocated in a 'learned' chunk of the arena
   bool garbage:1;     // can be garbage collected unless it is a 'reason'
-  bool gate:1 ;       // Clause part of a gate (function definition).
   bool hyper:1;       // redundant hyper binary or ternary resolved
-  bool instantiated:1;// tried to instantiate
   bool keep:1;        // always keep this clause (if redundant)
   bool moved:1;       // moved during garbage collector ('copy' valid)
   bool reason:1;      // reason / antecedent clause can not be collected
   bool redundant:1;   // aka 'learned' so not 'irredundant' (original)
-  bool transred:1;    // already checked for transitive reduction
-  bool subsume:1;     // not checked in last subsumption round
   unsigned used:2;    // resolved in conflict analysis since last 'reduce'
-  bool vivified:1;    // clause already vivified
-  bool vivify:1;      // clause scheduled to be vivified
 
   // The glucose level ('LBD' or short 'glue') is a heuristic value for the
   // expected usefulness of a learned clause, where smaller glue is consider
@@ -79,11 +96,23 @@ struct Clause {
   // See 'mark_useless_redundant_clauses_as_garbage' in 'reduce.cpp' and
   // 'bump_clause' in 'analyze.cpp'.
   //
+  // With cold flags in a side table the glue shares the first word with
+  // the flags above and thus is capped at 'max_glue' (see 'new_clause').
+  //
+#ifdef COLDFLAGS
+  int glue:23;
+  static const int max_glue = (1 << 22) - 1;
+#else
   int glue;
+#endif
 
   int size;         // Actual size of 'literals' (at least 2).
   int pos;          // Position of last watch replacement [Gent'13].
 
+#ifdef COLDFLAGS
+  unsigned cold;    // Index of cold flags in 'Internal::colds'.
+#endif
+
   union {
 
     int literals[2];    // Of variadic 'size' (shrunken if strengthened).
@@ -126,6 +155,17 @@ struct Clause {
   bool collect () const { return !reason && garbage; }
 };
 
+// During propagation only the header fields 'garbage', 'size' and 'pos'
+// are accessed besides the literals.  In both layouts the header of a
+// clause (without literals) takes 16 bytes and thus shares its cache line
+// with the first literals.  Without '-DCOLDFLAGS' adding more flags than
+// fit into the first word will trigger this compile time check.
+
+#ifndef LOGGING
+static_assert (offsetof (Clause, literals) == 16,
+  "clause header should fit into 16 bytes");
+#endif
+
 struct clause_smaller_size {
   bool operator () (const Clause * a, const Clause * b) {
     return a->size < b->size;
@@ -0,0 +1,124 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+ClauseTable::ClauseTable ()
+:
+  num_clauses (0), num_removed (0), size_table (0), table (0)
+{
+  // Initialize random number table for hash function.
+  //
+  Random random (42);
+  for (unsigned n = 0; n < num_nonces; n++) {
+    uint64_t nonce = random.next ();
+    if (!(nonce & 1)) nonce++;
+    assert (nonce), assert (nonce & 1);
+    nonces[n] = nonce;
+  }
+}
+
+ClauseTable::~ClauseTable () { delete [] table; }
+
+/*------------------------------------------------------------------------*/
+
+bool ClauseTable::normalize (vector<int> & clause) {
+  sort (clause.begin (), clause.end (), clause_lit_less_than ());
+  const auto end = clause.end ();
+  auto j = clause.begin ();
+  int prev = 0;
+  for (auto i = j; i != end; i++) {
+    int lit = *i;
+    if (lit == prev) continue;          // duplicated literal
+    if (lit == -prev) return true;      // tautological clause
+    *j++ = prev = lit;
+  }
+  clause.resize (j - clause.begin ());
+  return false;
+}
+
+uint64_t ClauseTable::hash (const vector<int> & clause) const {
+  unsigned j = 0;
+  uint64_t res = 0;
+  for (const auto & lit : clause) {
+    res += nonces[j++] * (uint64_t) lit;
+    if (j == num_nonces) j = 0;
+  }
+  return res;
+}
+
+uint64_t ClauseTable::reduce_hash (uint64_t hash, uint64_t size) {
+  assert (size > 0);
+  unsigned shift = 32;
+  uint64_t res = hash;
+  while ((((uint64_t)1) << shift) > size) {
+    res ^= res >> shift;
+    shift >>= 1;
+  }
+  res &= size - 1;
+  assert (res < size);
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Rehash all clauses into a new table of the given size, which also removes
+// all 'removed' slots.
+
+void ClauseTable::resize (uint64_t new_size_table) {
+  assert (new_size_table > 2*num_clauses);
+  ClauseSlot * old_table = table;
+  const uint64_t old_size_table = size_table;
+  table = new ClauseSlot [ new_size_table ];
+  size_table = new_size_table;
+  for (uint64_t i = 0; i < size_table; i++)
+    table[i].ref = empty;
+  for (uint64_t i = 0; i < old_size_table; i++) {
+    const ClauseSlot & slot = old_table[i];
+    if (slot.ref > removed) insert_slot (slot.hash, slot.ref);
+  }
+  num_removed = 0;
+  delete [] old_table;
+}
+
+// Linear probing starting at the reduced hash value.
+
+void ClauseTable::insert_slot (uint64_t hash, uint64_t ref) {
+  assert (ref > removed);
+  assert (num_clauses + num_removed < size_table);
+  uint64_t h = reduce_hash (hash, size_table);
+  while (table[h].ref > removed)
+    h = (h + 1) & (size_table - 1);
+  if (table[h].ref == removed) num_removed--;
+  table[h].hash = hash;
+  table[h].ref = ref;
+}
+
+// Keep the table at most half full (including removed slots).
+
+void ClauseTable::insert (uint64_t hash, uint64_t ref) {
+  if (2*(num_clauses + num_removed + 1) > size_table) {
+    uint64_t new_size_table = 2;
+    while (new_size_table < 4*(num_clauses + 1)) new_size_table *= 2;
+    resize (new_size_table);
+  }
+  insert_slot (hash, ref);
+  num_clauses++;
+}
+
+void ClauseTable::remove (uint64_t pos) {
+  assert (occupied (pos));
+  table[pos].ref = removed;
+  num_removed++;
+  assert (num_clauses);
+  num_clauses--;
+}
+
+void ClauseTable::clear () {
+  for (uint64_t i = 0; i < size_table; i++)
+    table[i].ref = empty;
+  num_clauses = num_removed = 0;
+}
+
+}
@@ -0,0 +1,97 @@
+#ifndef _clausetable_hpp_INCLUDED
+#define _clausetable_hpp_INCLUDED
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Hash table of clauses for the 'LratBuilder', which needs to find clauses
+// given by their literals (mostly for deletion).  The table does not store
+// clauses itself but only 64-bit references to them (pointers to the
+// clauses of the LRAT builder).  It uses open addressing with linear
+// probing and keeps the full 64-bit hash of the clause next to its
+// reference, so that searching only needs to look at clauses with
+// matching hash values.  The literals of clauses are hashed in sorted
+// order without duplicates (see 'normalize'), thus the hash value does
+// not depend on the order of the literals given.
+
+struct ClauseSlot {
+  uint64_t hash;                // previously computed full 64-bit hash
+  uint64_t ref;                 // reference, or 'empty' and 'removed'
+};
+
+class ClauseTable {
+
+public:
+
+  // References to clauses have to be different from these two.
+  //
+  static const uint64_t empty = 0;
+  static const uint64_t removed = 1;        // tombstone for linear probing
+
+private:
+
+  static const unsigned num_nonces = 4;
+
+  uint64_t nonces[num_nonces];  // random numbers for hashing
+
+  uint64_t num_clauses;         // number of clauses in table
+  uint64_t num_removed;         // number of removed slots
+  uint64_t size_table;          // size of table (power of two or zero)
+  ClauseSlot * table;
+
+  // Reduce hash value to the actual size.
+  //
+  static uint64_t reduce_hash (uint64_t hash, uint64_t size);
+
+  void resize (uint64_t);               // rehash into new table
+  void insert_slot (uint64_t hash, uint64_t ref);
+
+public:
+
+  ClauseTable ();
+  ~ClauseTable ();
+
+  // Sort literals and remove duplicates.  Returns 'true' if the clause is
+  // tautological (and then leaves it partially normalized).
+  //
+  static bool normalize (vector<int> &);
+
+  uint64_t hash (const vector<int> & normalized) const;
+
+  uint64_t size () const { return size_table; }
+  uint64_t clauses () const { return num_clauses; }
+
+  // Slots in the range '[0, size ())' which are neither 'empty' nor
+  // 'removed' refer to clauses.
+  //
+  uint64_t ref (uint64_t pos) const {
+    assert (pos < size_table);
+    return table[pos].ref;
+  }
+
+  bool occupied (uint64_t pos) const { return ref (pos) > removed; }
+
+  // Returns the position of the first clause with the given hash value for
+  // which 'match (ref)' returns 'true' or 'size ()' if there is none.
+  //
+  template<class Match> uint64_t find (uint64_t hash, Match match) const {
+    if (!size_table) return size_table;
+    for (uint64_t h = reduce_hash (hash, size_table), ref;
+         (ref = table[h].ref) != empty;
+         h = (h + 1) & (size_table - 1))
+      if (ref != removed && table[h].hash == hash && match (ref))
+        return h;
+    return size_table;
+  }
+
+  void insert (uint64_t hash, uint64_t ref);    // might resize table
+  void remove (uint64_t pos);                   // leaves 'removed' slot
+  void clear ();                                // but keep size
+};
+
+}
+
+#endif
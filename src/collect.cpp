@@ -169,10 +169,10 @@ inline void Internal::flush_watches (int lit, Watches & saved) {
   const_watch_iterator i;
   for (i = j; i != end; i++) {
     Watch w = *i;
-    Clause * c = w.clause;
+    Clause * c = w.clause ();
     if (c->collect ()) continue;
-    if (c->moved) c = w.clause = c->copy;
-    w.size = c->size;
+    if (c->moved) c = c->copy;
+    w.set_clause (c);
     const int new_blit_pos = (c->literals[0] == lit);
     assert (c->literals[!new_blit_pos] == lit);        /*FW1*/
     w.blit = c->literals[new_blit_pos];
@@ -260,6 +260,7 @@ void Internal::copy_clause (Clause * c) {
   assert (!c->moved);
   char * p = (char*) c;
   char * q = arena.copy (p, c->bytes ());
+  ((Clause *) q)->chunked = false;
   c->copy = (Clause *) q;
   c->moved = true;
   LOG ("copied clause[%" PRId64 "] from %p to %p",
@@ -324,9 +325,11 @@ void Internal::copy_non_garbage_clauses () {
 
     for (int sign = -1; sign <= 1; sign += 2)
       for (auto idx : vars)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+        for (const auto & w : watches (sign * likely_phase (idx))) {
+          Clause * c = w.clause ();
+          if (!c->moved && !c->collect ())
+            copy_clause (c);
+        }
 
   } else {
 
@@ -340,9 +343,11 @@ void Internal::copy_non_garbage_clauses () {
 
     for (int sign = -1; sign <= 1; sign += 2)
       for (int idx = queue.last; idx; idx = link (idx).prev)
-        for (const auto & w : watches (sign * likely_phase (idx)))
-          if (!w.clause->moved && !w.clause->collect ())
-            copy_clause (w.clause);
+        for (const auto & w : watches (sign * likely_phase (idx))) {
+          Clause * c = w.clause ();
+          if (!c->moved && !c->collect ())
+            copy_clause (c);
+        }
   }
 
   // Do not forget to move clauses which are not watched, which happened in
@@ -406,6 +411,25 @@ void Internal::check_clause_stats () {
 
 /*------------------------------------------------------------------------*/
 
+#ifdef COLDFLAGS
+
+// The cold flags of deleted clauses are still in the side table.  After
+// garbage collection the remaining clauses get consecutive indices again.
+
+void Internal::compact_colds () {
+  vector<ColdFlags> compacted;
+  compacted.reserve (clauses.size ());
+  for (const auto & c : clauses) {
+    compacted.push_back (cold (c));
+    c->cold = compacted.size () - 1;
+  }
+  colds.swap (compacted);
+}
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 bool Internal::arenaing () {
   return opts.arena && (stats.collections > 1);
 }
@@ -417,8 +441,11 @@ void Internal::garbage_collection () {
   stats.collections++;
   mark_satisfied_clauses_as_garbage ();
   if (!protected_reasons) protect_reasons ();
-  if (arenaing ()) copy_non_garbage_clauses ();
+  if (arenaing () || arena.allocated ()) copy_non_garbage_clauses ();
   else delete_garbage_clauses ();
+#ifdef COLDFLAGS
+  compact_colds ();
+#endif
   check_clause_stats ();
   check_var_stats ();
   unprotect_reasons ();
@@ -138,8 +138,11 @@ inline void Internal::unmark_in_candidate_clause (int lit) {
 /*------------------------------------------------------------------------*/
 
 struct less_conditioned {
+  Internal * internal;
+  less_conditioned (Internal * i) : internal (i) { }
   bool operator () (Clause * a, Clause * b) {
-    return !a->conditioned && b->conditioned;
+    return !internal->cold (a).conditioned &&
+            internal->cold (b).conditioned;
   }
 };
 
@@ -308,7 +311,7 @@ long Internal::condition_round (long delta) {
     if (positive > 0) {
       LOG (c, "found %d positive literals in candidate", positive);
       candidates.push_back (c);
-      if (c->conditioned) conditioned++;
+      if (cold (c).conditioned) conditioned++;
       else unconditioned++;
     }
 
@@ -426,14 +429,15 @@ long Internal::condition_round (long delta) {
   //
   assert (conditioned + unconditioned == candidates.size ());
   if (conditioned && unconditioned) {
-    stable_sort (candidates.begin (), candidates.end (), less_conditioned ());
+    stable_sort (candidates.begin (), candidates.end (),
+      less_conditioned (this));
     PHASE ("condition", stats.conditionings,
       "focusing on %zd candidates %.0f%% not tried last time",
       unconditioned, percent (unconditioned, candidates.size ()));
   } else if (conditioned && !unconditioned) {
     for (auto const & c : candidates) {
-      assert (c->conditioned);
-      c->conditioned = false;           // Reset 'conditioned' bit.
+      assert (cold (c).conditioned);
+      cold (c).conditioned = false;     // Reset 'conditioned' bit.
     }
     PHASE ("condition", stats.conditionings,
       "all %zd candidates tried before", conditioned);
@@ -479,7 +483,7 @@ long Internal::condition_round (long delta) {
     assert (!c->redundant);
 
     LOG (c, "candidate");
-    c->conditioned = 1;                 // Next time later.
+    cold (c).conditioned = 1;           // Next time later.
 
     // We watch an autarky literal in the clause, and can stop trying to
     // globally block the clause as soon it turns into a conditional
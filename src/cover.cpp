@@ -114,25 +114,26 @@ Internal::cover_propagate_asymmetric (int lit,
   const_watch_iterator i = j;
   while (!subsumed && i != eow) {
     const Watch w = *j++ = *i++;
-    if (w.clause == ignore) continue;   // costly but necessary here ...
+    Clause * c = w.clause ();
+    if (c == ignore) continue;   // costly but necessary here ...
     const signed char b = val (w.blit);
     if (b > 0) continue;
-    if (w.clause->garbage) j--;
+    if (c->garbage) j--;
     else if (w.binary ()) {
       if (b < 0) {
-        LOG (w.clause, "found subsuming");
+        LOG (c, "found subsuming");
         subsumed = true;
       } else asymmetric_literal_addition (-w.blit, coveror);
     } else {
-      literal_iterator lits = w.clause->begin ();
+      literal_iterator lits = c->begin ();
       const int other = lits[0]^lits[1]^lit;
       lits[0] = other, lits[1] = lit;
       const signed char u = val (other);
       if (u > 0) j[-1].blit = other;
       else {
-        const int size = w.clause->size;
+        const int size = c->size;
         const const_literal_iterator end = lits + size;
-        const literal_iterator middle = lits + w.clause->pos;
+        const literal_iterator middle = lits + c->pos;
         literal_iterator k = middle;
         signed char v = -1;
         int r = 0;
@@ -140,25 +141,25 @@ Internal::cover_propagate_asymmetric (int lit,
           k++;
         if (v < 0) {
           k = lits + 2;
-          assert (w.clause->pos <= size);
+          assert (c->pos <= size);
           while (k != middle && (v = val (r = *k)) < 0)
             k++;
         }
-        w.clause->pos = k - lits;
-        assert (lits + 2 <= k), assert (k <= w.clause->end ());
+        c->pos = k - lits;
+        assert (lits + 2 <= k), assert (k <= c->end ());
         if (v > 0) j[-1].blit = r;
         else if (!v) {
-          LOG (w.clause, "unwatch %d in", lit);
+          LOG (c, "unwatch %d in", lit);
           lits[1] = r;
           *k = lit;
-          watch_literal (r, lit, w.clause);
+          watch_literal (r, lit, c);
           j--;
         } else if (!u) {
           assert (v < 0);
           asymmetric_literal_addition (-other, coveror);
         } else {
           assert (u < 0), assert (v < 0);
-          LOG (w.clause, "found subsuming");
+          LOG (c, "found subsuming");
           subsumed = true;
           break;
         }
@@ -394,9 +395,13 @@ bool Internal::cover_clause (Clause * c, Coveror & coveror) {
 // Not yet tried and larger clauses are tried first.
 
 struct clause_covered_or_smaller {
+  Internal * internal;
+  clause_covered_or_smaller (Internal * i) : internal (i) { }
   bool operator () (const Clause * a, const Clause * b) {
-    if (a->covered && !b->covered) return true;
-    if (!a->covered && b->covered) return false;
+    const bool a_covered = internal->cold (a).covered;
+    const bool b_covered = internal->cold (b).covered;
+    if (a_covered && !b_covered) return true;
+    if (!a_covered && b_covered) return false;
     return a->size < b->size;
   }
 };
@@ -429,7 +434,7 @@ int64_t Internal::cover_round () {
   int64_t untried = 0;
   //
   for (auto c : clauses) {
-    assert (!c->frozen);
+    assert (!cold (c).frozen);
     if (c->garbage) continue;
     if (c->redundant) continue;
     bool satisfied = false, allfrozen = true;
@@ -437,12 +442,12 @@ int64_t Internal::cover_round () {
       if (val (lit) > 0) { satisfied = true; break; }
       else if (allfrozen && !frozen (lit)) allfrozen = false;
     if (satisfied) { mark_garbage (c); continue; }
-    if (allfrozen) { c->frozen = true; continue; }
+    if (allfrozen) { cold (c).frozen = true; continue; }
     for (const auto & lit : *c)
       occs (lit).push_back (c);
     if (c->size < opts.coverminclslim) continue;
     if (c->size > opts.covermaxclslim) continue;
-    if (c->covered) continue;
+    if (cold (c).covered) continue;
     schedule.push_back (c);
     untried++;
   }
@@ -455,11 +460,11 @@ int64_t Internal::cover_round () {
     for (auto c : clauses) {
       if (c->garbage) continue;
       if (c->redundant) continue;
-      if (c->frozen) { c->frozen = false; continue; }
+      if (cold (c).frozen) { cold (c).frozen = false; continue; }
       if (c->size < opts.coverminclslim) continue;
       if (c->size > opts.covermaxclslim) continue;
-      assert (c->covered);
-      c->covered = false;
+      assert (cold (c).covered);
+      cold (c).covered = false;
       schedule.push_back (c);
     }
   } else {      // Mix of tried and not tried clauses ....
@@ -467,16 +472,16 @@ int64_t Internal::cover_round () {
     for (auto c : clauses) {
       if (c->garbage) continue;
       if (c->redundant) continue;
-      if (c->frozen) { c->frozen = false; continue; }
+      if (cold (c).frozen) { cold (c).frozen = false; continue; }
       if (c->size < opts.coverminclslim) continue;
       if (c->size > opts.covermaxclslim) continue;
-      if (!c->covered) continue;
+      if (!cold (c).covered) continue;
       schedule.push_back (c);
     }
   }
 
   stable_sort (schedule.begin (), schedule.end (),
-    clause_covered_or_smaller ());
+    clause_covered_or_smaller (this));
 
 #ifndef QUIET
   const size_t scheduled = schedule.size ();
@@ -505,7 +510,7 @@ int64_t Internal::cover_round () {
          stats.propagations.cover < limit) {
     Clause * c = schedule.back ();
     schedule.pop_back ();
-    c->covered = true;
+    cold (c).covered = true;
     if (cover_clause (c, coveror)) covered++;
   }
 
@@ -58,7 +58,7 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
         if (!w.binary ()) continue;
         int other = w.blit;
         const int tmp = marked (other);
-        Clause * c = w.clause;
+        Clause * c = w.clause ();
 
         if (tmp > 0) {                  // Found duplicated binary clause.
 
@@ -75,7 +75,7 @@ void Internal::mark_duplicated_binary_clauses_as_garbage () {
               assert (k != i);
               if (!k->binary ()) continue;
               if (k->blit != other) continue;
-              Clause * d = k->clause;
+              Clause * d = k->clause ();
               if (d->garbage) continue;
               c = d;
               break;
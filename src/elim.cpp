@@ -408,7 +408,7 @@ Internal::elim_resolvents_are_bounded (Eliminator & eliminator, int pivot)
     for (const auto & d : ns) {
       assert (!d->redundant);
       if (d->garbage) continue;
-      if (substitute && c->gate == d->gate) continue;
+      if (substitute && cold (c).gate == cold (d).gate) continue;
       stats.elimrestried++;
       if (resolve_clauses (eliminator, c, pivot, d, true)) {
         resolvents++;
@@ -467,7 +467,7 @@ Internal::elim_add_resolvents (Eliminator & eliminator, int pivot) {
     for (auto & d : ns) {
       if (unsat) break;
       if (d->garbage) continue;
-      if (substitute && c->gate == d->gate) continue;
+      if (substitute && cold (c).gate == cold (d).gate) continue;
       if (!resolve_clauses (eliminator, c, pivot, d, false)) continue;
       Clause * r = new_resolved_irredundant_clause ();
       elim_update_added_clause (eliminator, r);
@@ -505,7 +505,7 @@ Internal::mark_eliminated_clauses_as_garbage (Eliminator & eliminator,
     if (c->garbage) continue;
     mark_garbage (c);
     assert (!c->redundant);
-    if (!substitute || c->gate) {
+    if (!substitute || cold (c).gate) {
       external->push_clause_on_extension_stack (c, pivot);
       pushed++;
     }
@@ -520,7 +520,7 @@ Internal::mark_eliminated_clauses_as_garbage (Eliminator & eliminator,
     if (d->garbage) continue;
     mark_garbage (d);
     assert (!d->redundant);
-    if (!substitute || d->gate) {
+    if (!substitute || cold (d).gate) {
       external->push_clause_on_extension_stack (d, -pivot);
       pushed++;
     }
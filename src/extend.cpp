@@ -133,6 +133,7 @@ void External::extend () {
         assert (i != begin);
     else {
       while ((lit = *--i)) {
+        if (lit == INT_MIN) continue;           // Restored (see 'restore').
         const int tmp = ival (lit);             // not 'signed char'!!!
         if (tmp < 0) {
           LOG ("flipping blocking literal %d", lit);
@@ -171,7 +172,8 @@ bool External::traverse_witnesses_backward (WitnessIterator & it) {
       witness.push_back (lit);
     reverse (clause.begin (), clause.end ());
     reverse (witness.begin (), witness.end ());
-    if (!it.witness (clause, witness))
+    if ((witness.empty () || witness[0] != INT_MIN) &&
+        !it.witness (clause, witness))
       return false;
     clause.clear ();
     witness.clear ();
@@ -194,7 +196,8 @@ bool External::traverse_witnesses_forward (WitnessIterator & it) {
       assert (i != end);
       while (i != end && (lit = *i++))
         clause.push_back (lit);
-      if (!it.witness (clause, witness))
+      if ((witness.empty () || witness[0] != INT_MIN) &&
+          !it.witness (clause, witness))
         return false;
       clause.clear ();
       witness.clear ();
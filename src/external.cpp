@@ -8,8 +8,11 @@ External::External (Internal * i)
   max_var (0),
   vsize (0),
   extended (false),
+  indexed (0),
+  removed (0),
   terminator (0),
   learner (0),
+  source (0),
   solution (0),
   vars (max_var)
 {
@@ -143,6 +146,29 @@ void External::add (int elit) {
   internal->add_original_lit (ilit);
 }
 
+// Same as calling 'add' on all 'size' literals but reserves variables up to
+// the maximum variable 'max_eidx' in the buffer once and avoids pushing
+// each literal through 'add_original_lit' separately.
+
+void External::add_clauses (const int * elits, size_t size, int max_eidx) {
+  reset_extended ();
+  if (max_eidx > max_var) init (max_eidx);
+  if (internal->opts.check &&
+      (internal->opts.checkwitness || internal->opts.checkfailed))
+    original.insert (original.end (), elits, elits + size);
+  vector<int> & clause = internal->original;
+  for (const int * p = elits, * end = elits + size; p != end; p++) {
+    const int elit = *p;
+    assert (elit != INT_MIN);
+    if (elit) {
+      const int ilit = internalize (elit);
+      assert (ilit);
+      LOG ("adding external %d as internal %d", elit, ilit);
+      clause.push_back (ilit);
+    } else internal->add_original_lit (0);
+  }
+}
+
 void External::assume (int elit) {
   assert (elit);
   reset_extended ();
@@ -282,23 +308,44 @@ int External::lookahead () {
   return elit;
 }
 
-CaDiCaL::CubesWithStatus External::generate_cubes (int depth, int min_depth = 0) {
+// Maps the internal literals of generated cubes to external literals
+// before passing them on to the sink of the user.
+
+struct ExternalCubeSink : public CubeSink {
+  Internal * internal;
+  CubeSink & sink;
+  vector<int> ecube;
+  ExternalCubeSink (Internal * i, CubeSink & s) : internal (i), sink (s) { }
+  bool cube (const vector<int> & icube) {
+    ecube.clear ();
+    for (const auto & ilit : icube) {
+      const int elit = internal->externalize (ilit);
+      LOG ("cube internal %d external %d", ilit, elit);
+      ecube.push_back (elit);
+    }
+    return sink.cube (ecube);
+  }
+};
+
+int External::generate_cubes (int depth, int min_depth, CubeSink & sink) {
   reset_extended ();
   update_molten_literals ();
   reset_limits ();
-  auto cubes = internal->generate_cubes (depth, min_depth);
-  auto externalize = [this](int ilit) {
-    const int elit = ilit ? internal->externalize (ilit) : 0;
-    MSG ("lookahead internal %d external %d", ilit, elit);
-    return elit;
-  };
-  auto externalize_map = [this, externalize](std::vector<int> cube) {
-    (void) this;
-    MSG("Cube : ");
-    std::for_each(begin(cube), end(cube), externalize);
-  };
-  std::for_each(begin(cubes.cubes), end(cubes.cubes), externalize_map);
+  ExternalCubeSink external_sink (internal, sink);
+  return internal->generate_cubes (depth, min_depth, external_sink);
+}
 
+struct CubeCollector : public CubeSink {
+  vector<vector<int>> & cubes;
+  CubeCollector (vector<vector<int>> & c) : cubes (c) { }
+  bool cube (const vector<int> & c) { cubes.push_back (c); return true; }
+};
+
+CaDiCaL::CubesWithStatus External::generate_cubes (int depth, int min_depth = 0) {
+  CubesWithStatus cubes;
+  CubeCollector collector (cubes.cubes);
+  cubes.status = generate_cubes (depth, min_depth, collector);
+  if (cubes.status) cubes.cubes.clear ();
   return cubes;
 }
 
@@ -76,6 +76,17 @@ struct External {
   vector<bool> witness;       // Literal witness on extension stack.
   vector<bool> tainted;       // Literal tainted in adding literals.
 
+  // For restoring only the clauses of tainted literals without scanning
+  // the whole extension stack we index the positions of the clauses on the
+  // extension stack by their witness literals (see 'restore.cpp').  Only
+  // the first 'indexed' entries of the extension stack are indexed and the
+  // index is extended lazily. Restored clauses are not removed immediately
+  // but their witness literals are overwritten with 'INT_MIN' instead.
+  //
+  vector<vector<size_t>> witnessed; // Indexed by 'elit2ulit'.
+  size_t indexed;             // Indexed prefix of extension stack.
+  size_t removed;             // Entries of removed clauses.
+
   vector<unsigned> frozentab; // Reference counts for frozen variables.
 
   // Regularly checked terminator if non-zero.  The terminator is set from
@@ -91,6 +102,11 @@ struct External {
   void export_learned_unit_clause (int ilit);
   void export_learned_large_clause (const vector<int> &);
 
+  // If there is a clause source import clauses during restarts (see
+  // 'import_clauses' in 'import.cpp').
+
+  ClauseSource * source;
+
   //----------------------------------------------------------------------//
 
   signed char * solution;     // Given solution checking for debugging.
@@ -191,6 +207,9 @@ struct External {
     const vector<int>::const_iterator & begin,
     const vector<int>::const_iterator & end);
 
+  void index_extension ();
+  void restore_clauses_by_scanning ();
+  void restore_clauses_by_index ();
   void restore_clauses ();
 
   /*----------------------------------------------------------------------*/
@@ -252,6 +271,7 @@ struct External {
   // Proxies to IPASIR functions.
 
   void add (int elit);
+  void add_clauses (const int * elits, size_t size, int max_eidx);
   void assume (int elit);
   int solve (bool preprocess_only);
 
@@ -295,6 +315,7 @@ struct External {
 
   int lookahead();
   CaDiCaL::CubesWithStatus generate_cubes(int, int);
+  int generate_cubes(int, int, CubeSink &);
 
   int fixed (int elit) const;   // Implemented in 'internal.hpp'.
 
@@ -11,6 +11,9 @@ extern "C" {
 #include <sys/types.h>
 #include <unistd.h>
 #include <stdlib.h>
+#ifndef NMMAP
+#include <sys/mman.h>
+#endif
 }
 
 /*------------------------------------------------------------------------*/
@@ -30,7 +33,11 @@ File::File (Internal *i, bool w, int c, FILE * f, const char * n)
   writing (w),
 #endif
   close_file (c), file (f),
-  _name (n), _lineno (1), _bytes (0)
+  _name (n), _lineno (1), _bytes (0),
+  buffered (false), chunk (0), chunk_end (0), inflater (0)
+#ifndef NMMAP
+  , mapped (0), mapped_bytes (0)
+#endif
 {
   (void) i, (void) w;
   assert (f), assert (n);
@@ -197,6 +204,23 @@ FILE * File::read_pipe (Internal * internal,
   return open_pipe (internal, fmt, path, "r");
 }
 
+// Open a compressed file for in-process decompression after checking that
+// it exists and matches the signature as for 'read_pipe'.
+
+FILE * File::read_compressed (Internal * internal,
+                              const int * sig,
+                              const char * path) {
+  if (!File::exists (path)) {
+    LOG ("file '%s' does not exist", path);
+    return 0;
+  }
+  LOG ("file '%s' exists", path);
+  if (sig && !File::match (internal, path, sig)) return 0;
+  LOG ("file '%s' matches signature", path);
+  MSG ("opening file to decompress '%s'", path);
+  return open_file (internal, path, "r");
+}
+
 FILE * File::write_pipe (Internal * internal,
                          const char * fmt, const char * path) {
   MSG ("opening pipe to write '%s'", path);
@@ -216,17 +240,33 @@ File * File::write (Internal * internal, FILE * f, const char * n) {
 File * File::read (Internal * internal, const char * path) {
   FILE * file;
   int close_input = 2;
+  int format = 0;
   if (has_suffix (path, ".xz")) {
+#ifndef NLZMA
+    file = read_compressed (internal, xzsig, path);
+    format = Inflater::XZ, close_input = 3;
+#else
     file = read_pipe (internal, "xz -c -d %s", xzsig, path);
+#endif
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".lzma")) {
+#ifndef NLZMA
+    file = read_compressed (internal, lzmasig, path);
+    format = Inflater::LZMA, close_input = 3;
+#else
     file = read_pipe (internal, "lzma -c -d %s", lzmasig, path);
+#endif
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".bz2")) {
     file = read_pipe (internal, "bzip2 -c -d %s", bz2sig, path);
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".gz")) {
+#ifndef NZLIB
+    file = read_compressed (internal, gzsig, path);
+    format = Inflater::GZIP, close_input = 3;
+#else
     file = read_pipe (internal, "gzip -c -d %s", gzsig, path);
+#endif
     if (!file) goto READ_FILE;
   } else if (has_suffix (path, ".7z")) {
     file = read_pipe (internal, "7z x -so %s 2>/dev/null", sig7z, path);
@@ -237,7 +277,17 @@ READ_FILE:
     close_input = 1;
   }
 
-  return file ? new File (internal, false, close_input, file, path) : 0;
+  if (!file) return 0;
+
+  File * res = new File (internal, false, close_input, file, path);
+  if (close_input == 3 && !res->inflate (format)) {
+    delete res;
+    return 0;
+  }
+#ifndef NMMAP
+  if (close_input == 1) res->map ();
+#endif
+  return res;
 }
 
 File * File::write (Internal * internal, const char * path) {
@@ -258,8 +308,99 @@ File * File::write (Internal * internal, const char * path) {
   return file ? new File (internal, true, close_input, file, path) : 0;
 }
 
+/*------------------------------------------------------------------------*/
+
+// Start in-process decompression of the (compressed) file.
+
+bool File::inflate (int format) {
+  assert (!writing);
+  assert (!inflater);
+  assert (close_file == 3);
+#ifndef NINFLATE
+  inflater = new Inflater (file, (Inflater::Format) format);
+  if (!inflater->init ()) {
+    MSG ("failed to initialize decompression of '%s'", name ());
+    return false;
+  }
+  buffered = true;
+  return true;
+#else
+  (void) format;
+  return false;
+#endif
+}
+
+// Called by 'get' if all characters of the current chunk have been read.
+
+int File::refill () {
+  assert (buffered);
+  assert (chunk == chunk_end);
+#ifndef NINFLATE
+  if (inflater && inflater->next (chunk, chunk_end)) {
+    assert (chunk < chunk_end);
+    return *chunk++;
+  }
+  if (inflater) {
+#ifndef QUIET
+    if (inflater->error ())
+      WARNING ("decompressing '%s' failed: %s",
+        name (), inflater->error ());
+#endif
+    delete inflater;            // Warn only once and release buffers.
+    inflater = 0;
+  }
+#endif
+  return EOF;
+}
+
+/*------------------------------------------------------------------------*/
+#ifndef NMMAP
+
+// Map a regular file into memory and let 'get' read from memory.  If this
+// fails we silently fall back to reading the file through 'stdio'.
+
+void File::map () {
+  assert (!writing);
+  assert (!mapped);
+  const int fd = fileno (file);
+  struct stat buf;
+  if (fstat (fd, &buf)) return;
+  if (!S_ISREG (buf.st_mode)) return;
+  if (buf.st_size <= 0) return;
+  const size_t bytes = buf.st_size;
+  void * res = mmap (0, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (res == MAP_FAILED) {
+    MSG ("memory mapping '%s' failed", name ());
+    return;
+  }
+#ifdef MADV_SEQUENTIAL
+  madvise (res, bytes, MADV_SEQUENTIAL);
+#endif
+  mapped = (const unsigned char *) res;
+  mapped_bytes = bytes;
+  buffered = true;
+  chunk = mapped;
+  chunk_end = mapped + mapped_bytes;
+  MSG ("memory mapped %" PRIu64 " bytes of '%s'", mapped_bytes, name ());
+}
+
+void File::unmap () {
+  assert (mapped);
+  munmap ((void *) mapped, mapped_bytes);
+  mapped = 0;
+  mapped_bytes = 0;
+  buffered = false;
+  chunk = chunk_end = 0;
+}
+
+#endif
+/*------------------------------------------------------------------------*/
+
 void File::close () {
   assert (file);
+#ifndef NMMAP
+  if (mapped) unmap ();
+#endif
   if (close_file == 0) {
     MSG ("disconnecting from '%s'", name ());
   }
@@ -271,6 +412,16 @@ void File::close () {
     MSG ("closing pipe command on '%s'", name ());
     pclose (file);
   }
+  if (close_file == 3) {
+    MSG ("closing decompressed file '%s'", name ());
+#ifndef NINFLATE
+    delete inflater;
+    inflater = 0;
+#endif
+    buffered = false;
+    chunk = chunk_end = 0;
+    fclose (file);
+  }
 
   file = 0;     // mark as closed
 
@@ -281,7 +432,7 @@ void File::close () {
     MSG ("after writing %" PRIu64 " bytes %.1f MB", bytes (), mb);
   else
     MSG ("after reading %" PRIu64 " bytes %.1f MB", bytes (), mb);
-  if (close_file == 2) {
+  if (close_file >= 2) {
     int64_t s = size (name ());
     double mb = s / (double) (1<<20);
     if (writing)
@@ -24,9 +24,14 @@ namespace CaDiCaL {
 // Wraps a 'C' file 'FILE' with name and supports zipped reading and writing
 // through 'popen' using external helper tools.  Reading has line numbers.
 // Compression and decompression relies on external utilities, e.g., 'gzip',
-// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.
+// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.  If compiled with
+// 'zlib' or 'liblzma' support, 'gzip', 'xz' and 'lzma' compressed files
+// are decompressed in-process instead (see 'inflate.hpp').  Uncompressed
+// regular files are memory mapped for reading (unless compiled with
+// '-DNMMAP'), which avoids copying them through 'stdio' buffers.
 
 struct Internal;
+class Inflater;
 
 class File {
 
@@ -37,12 +42,31 @@ class File {
   bool writing;
 #endif
 
-  int close_file;       // need to close file (1=fclose, 2=pclose)
+  int close_file;       // need to close (1=fclose, 2=pclose, 3=inflated)
   FILE * file;
   const char * _name;
   uint64_t _lineno;
   uint64_t _bytes;
 
+  // Memory mapped and decompressed files are read from memory.  The
+  // characters in '[chunk, chunk_end)' are read next by 'get' and then
+  // 'refill' is called to obtain the next chunk (if 'buffered' is set).
+
+  bool buffered;
+  const unsigned char * chunk;
+  const unsigned char * chunk_end;
+  int refill ();
+
+  Inflater * inflater;          // In-process decompression if non-zero.
+  bool inflate (int format);
+
+#ifndef NMMAP
+  const unsigned char * mapped; // Memory mapped file if non-zero.
+  uint64_t mapped_bytes;        // Size of memory mapped file.
+  void map ();
+  void unmap ();
+#endif
+
   File (Internal *, bool, int, FILE *, const char *);
 
   static FILE * open_file (Internal *,
@@ -58,6 +82,9 @@ class File {
                            const char * fmt,
                            const int * sig,
                            const char * path);
+  static FILE * read_compressed (Internal *,
+                                 const int * sig,
+                                 const char * path);
   static FILE * write_pipe (Internal *,
                             const char * fmt, const char * path);
 public:
@@ -93,7 +120,10 @@ public:
 
   int get () {
     assert (!writing);
-    int res = cadical_getc_unlocked (file);
+    int res;
+    if (chunk < chunk_end) res = *chunk++;
+    else if (buffered) res = refill ();
+    else res = cadical_getc_unlocked (file);
     if (res == '\n') _lineno++;
     if (res != EOF) _bytes++;
     return res;
@@ -119,6 +149,13 @@ public:
     return true;
   }
 
+  bool put (const unsigned char * buffer, size_t size) {
+    assert (writing);
+    if (fwrite (buffer, 1, size, file) != size) return false;
+    _bytes += size;
+    return true;
+  }
+
   bool put (int lit) {
     assert (writing);
     if (!lit) return put ('0');
@@ -135,8 +135,8 @@ void Internal::find_equivalence (Eliminator & eliminator, int pivot) {
     stats.elimgates++;
 
     LOG (c, "first gate clause");
-    assert (!c->gate);
-    c->gate = true;
+    assert (!cold (c).gate);
+    cold (c).gate = true;
     eliminator.gates.push_back (c);
 
     Clause * d = 0;
@@ -150,8 +150,8 @@ void Internal::find_equivalence (Eliminator & eliminator, int pivot) {
     assert (d);
 
     LOG (d, "second gate clause");
-    assert (!d->gate);
-    d->gate = true;
+    assert (!cold (d).gate);
+    cold (d).gate = true;
     eliminator.gates.push_back (d);
 
     break;
@@ -231,8 +231,8 @@ void Internal::find_and_gate (Eliminator & eliminator, int pivot) {
     stats.elimgates++;
 
     (void) arity;
-    assert (!c->gate);
-    c->gate = true;
+    assert (!cold (c).gate);
+    cold (c).gate = true;
     eliminator.gates.push_back (c);
     for (const auto & lit : *c) {
       if (lit == -pivot) continue;
@@ -253,8 +253,8 @@ void Internal::find_and_gate (Eliminator & eliminator, int pivot) {
       const int tmp = marked (other);
       if (tmp != 2) continue;
       LOG (d, "AND gate binary side clause");
-      assert (!d->gate);
-      d->gate = true;
+      assert (!cold (d).gate);
+      cold (d).gate = true;
       eliminator.gates.push_back (d);
       count++;
     }
@@ -353,14 +353,14 @@ void Internal::find_if_then_else (Eliminator & eliminator, int pivot) {
       LOG (d1, "3rd if-then-else");
       LOG (d2, "4th if-then-else");
       LOG ("found ITE gate %d == (%d ? %d : %d)", pivot, -bi, -ci, -cj);
-      assert (!di->gate);
-      assert (!dj->gate);
-      assert (!d1->gate);
-      assert (!d2->gate);
-      di->gate = true;
-      dj->gate = true;
-      d1->gate = true;
-      d2->gate = true;
+      assert (!cold (di).gate);
+      assert (!cold (dj).gate);
+      assert (!cold (d1).gate);
+      assert (!cold (d2).gate);
+      cold (di).gate = true;
+      cold (dj).gate = true;
+      cold (d1).gate = true;
+      cold (d2).gate = true;
       eliminator.gates.push_back (di);
       eliminator.gates.push_back (dj);
       eliminator.gates.push_back (d1);
@@ -487,8 +487,8 @@ void Internal::find_xor_gate (Eliminator & eliminator, int pivot) {
     auto j = eliminator.gates.begin ();
     for (auto i = j; i != end; i++) {
       Clause * e = *i;
-      if (e->gate) continue;
-      e->gate = true;
+      if (cold (e).gate) continue;
+      cold (e).gate = true;
       LOG (e, "contributing");
       *j++ = e;
     }
@@ -524,8 +524,8 @@ void Internal::find_gate_clauses (Eliminator & eliminator, int pivot)
 void Internal::unmark_gate_clauses (Eliminator & eliminator) {
   LOG ("unmarking %zd gate clauses", eliminator.gates.size ());
   for (const auto & c : eliminator.gates) {
-    assert (c->gate);
-    c->gate = false;
+    assert (cold (c).gate);
+    cold (c).gate = false;
   }
   eliminator.gates.clear ();
 }
@@ -0,0 +1,84 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+// Clauses can be imported from a clause source connected through the API,
+// for instance by portfolio solvers sharing learned clauses.  The source is
+// polled during restarts.  As soon as it provides a clause we backtrack to
+// the root level, where all assigned literals are fixed.  Then satisfied
+// clauses can be ignored and falsified literals removed, such that the
+// remaining literals are all unassigned and can be watched.
+
+// Imported clauses can not be justified in the proof, since they are not
+// necessarily implied by the clauses of this solver through unit
+// propagation.  Thus nothing is imported if proofs are traced or checked.
+// We further skip clauses with a literal whose negation is a witness on the
+// extension stack, since flipping that witness during solution
+// reconstruction might falsify the imported clause.
+
+void Internal::import_clause (const vector<int> & eclause, int glue) {
+
+  assert (!level);
+  assert (clause.empty ());
+
+  bool skip = false;
+
+  for (const auto elit : eclause) {
+    const int eidx = abs (elit);
+    if (!elit || eidx > external->max_var) { skip = true; break; }
+    int ilit = external->e2i[eidx];
+    if (!ilit) { skip = true; break; }
+    if (external->marked (external->witness, -elit)) {
+      skip = true;                              // might be flipped
+      break;
+    }
+    if (elit < 0) ilit = -ilit;
+    const Flags & f = flags (ilit);
+    if (!f.active () && !f.fixed ()) { skip = true; break; }
+    const signed char tmp = val (ilit);
+    if (tmp > 0) { skip = true; break; }        // satisfied
+    if (tmp < 0) continue;                      // falsified
+    const signed char m = marked (ilit);
+    if (m > 0) continue;                        // duplicated
+    if (m < 0) { skip = true; break; }          // tautological
+    mark (ilit);
+    clause.push_back (ilit);
+  }
+
+  for (const auto & lit : clause)
+    unmark (lit);
+
+  if (skip) {
+    LOG ("skipping imported clause of size %zd", eclause.size ());
+    stats.imported.skipped++;
+  } else if (clause.empty ()) {
+    LOG ("imported empty clause");
+    learn_empty_clause ();
+  } else if (clause.size () == 1) {
+    const int unit = clause[0];
+    LOG ("imported unit clause %d", unit);
+    assign_unit (unit);
+    stats.imported.units++;
+  } else {
+    Clause * c = new_clause (true, glue);
+    LOG (c, "imported");
+    watch_clause (c);
+    stats.imported.clauses++;
+  }
+
+  clause.clear ();
+}
+
+void Internal::import_clauses () {
+  assert (external->source);
+  if (proof) return;
+  vector<int> eclause;
+  int glue;
+  while (!unsat && external->source->import (eclause, glue)) {
+    if (level) backtrack ();
+    import_clause (eclause, glue);
+    eclause.clear ();
+  }
+}
+
+}
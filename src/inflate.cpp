@@ -0,0 +1,221 @@
+#include "internal.hpp"
+
+#ifndef NINFLATE
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+Inflater::Inflater (FILE * f, Format t)
+:
+  file (f), format (t), failed (0), finished (false), ended (false),
+  eof (false),
+#ifndef NZLIB
+  zlib (0),
+#endif
+#ifndef NLZMA
+  lzma (0),
+#endif
+  input (0), consumed (0)
+#ifndef NTHREADS
+  , producer (0), stopped (false), done (false)
+#endif
+{
+  assert (file);
+  for (auto & chunk : chunks)
+    chunk.data = 0, chunk.bytes = 0, chunk.full = false;
+}
+
+bool Inflater::init () {
+  switch (format) {
+#ifndef NZLIB
+    case GZIP:
+      zlib = new z_stream ();
+      if (inflateInit2 (zlib, 15 + 16) != Z_OK) {
+        delete zlib;
+        zlib = 0;
+        return false;
+      }
+      break;
+#endif
+#ifndef NLZMA
+    case XZ:
+    case LZMA: {
+      const lzma_stream init = LZMA_STREAM_INIT;
+      lzma = new lzma_stream (init);
+      lzma_ret ret;
+      if (format == XZ)
+        ret = lzma_stream_decoder (lzma, UINT64_MAX, LZMA_CONCATENATED);
+      else
+        ret = lzma_alone_decoder (lzma, UINT64_MAX);
+      if (ret != LZMA_OK) {
+        delete lzma;
+        lzma = 0;
+        return false;
+      }
+    } break;
+#endif
+    default:
+      return false;
+  }
+  input = new unsigned char [input_bytes];
+  for (auto & chunk : chunks)
+    chunk.data = new unsigned char [chunk_bytes];
+#ifndef NTHREADS
+  producer = new std::thread (&Inflater::produce, this);
+#endif
+  return true;
+}
+
+Inflater::~Inflater () {
+#ifndef NTHREADS
+  if (producer) {
+    {
+      std::lock_guard<std::mutex> lock (mutex);
+      stopped = true;
+    }
+    changed.notify_all ();
+    producer->join ();
+    delete producer;
+  }
+#endif
+#ifndef NZLIB
+  if (zlib) inflateEnd (zlib), delete zlib;
+#endif
+#ifndef NLZMA
+  if (lzma) lzma_end (lzma), delete lzma;
+#endif
+  for (auto & chunk : chunks)
+    delete [] chunk.data;
+  delete [] input;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Fill 'buffer' with at most 'size' decompressed bytes and return the
+// number of bytes written.  Returns zero if the compressed file is
+// exhausted or decompression failed before.  Concatenated 'gzip' members
+// and 'xz' streams are decompressed one after the other as the command
+// line tools do.
+
+size_t Inflater::decompress (unsigned char * buffer, size_t size) {
+
+  if (finished || failed) return 0;
+
+#ifndef NZLIB
+  if (zlib) {
+    zlib->next_out = buffer;
+    zlib->avail_out = size;
+    while (zlib->avail_out) {
+      if (!zlib->avail_in) {
+        size_t bytes = fread (input, 1, input_bytes, file);
+        if (ferror (file)) { failed = "read error"; break; }
+        if (!bytes) {
+          if (ended) finished = true;
+          else failed = "unexpected end of file";
+          break;
+        }
+        zlib->next_in = input;
+        zlib->avail_in = bytes;
+        if (ended) inflateReset (zlib), ended = false;
+      }
+      int ret = ::inflate (zlib, Z_NO_FLUSH);
+      if (ret == Z_STREAM_END) {
+        if (zlib->avail_in) inflateReset (zlib);
+        else ended = true;
+      } else if (ret != Z_OK) { failed = "corrupted data"; break; }
+    }
+    return size - zlib->avail_out;
+  }
+#endif
+
+#ifndef NLZMA
+  if (lzma) {
+    lzma->next_out = buffer;
+    lzma->avail_out = size;
+    while (lzma->avail_out) {
+      if (!lzma->avail_in && !eof) {
+        size_t bytes = fread (input, 1, input_bytes, file);
+        if (ferror (file)) { failed = "read error"; break; }
+        if (!bytes) eof = true;
+        lzma->next_in = input;
+        lzma->avail_in = bytes;
+      }
+      lzma_ret ret = lzma_code (lzma, eof ? LZMA_FINISH : LZMA_RUN);
+      if (ret == LZMA_STREAM_END) { finished = true; break; }
+      if (ret != LZMA_OK) {
+        failed = (ret == LZMA_BUF_ERROR) ? "unexpected end of file"
+                                          : "corrupted data";
+        break;
+      }
+    }
+    return size - lzma->avail_out;
+  }
+#endif
+
+  return 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+#ifndef NTHREADS
+
+// The producer thread fills the two chunks alternately and waits for the
+// consumer to release a chunk before overwriting it.
+
+void Inflater::produce () {
+  for (unsigned produced = 0;; produced++) {
+    Chunk & chunk = chunks[produced & 1];
+    {
+      std::unique_lock<std::mutex> lock (mutex);
+      changed.wait (lock, [&] { return stopped || !chunk.full; });
+      if (stopped) return;
+    }
+    const size_t bytes = decompress (chunk.data, chunk_bytes);
+    {
+      std::lock_guard<std::mutex> lock (mutex);
+      if (bytes) chunk.bytes = bytes, chunk.full = true;
+      else done = true;
+    }
+    changed.notify_all ();
+    if (!bytes) return;
+  }
+}
+
+bool Inflater::next (const unsigned char * & begin,
+                     const unsigned char * & end) {
+  std::unique_lock<std::mutex> lock (mutex);
+  if (consumed) {
+    Chunk & previous = chunks[(consumed - 1) & 1];
+    if (previous.full) {
+      previous.full = false;
+      changed.notify_all ();
+    }
+  }
+  Chunk & chunk = chunks[consumed & 1];
+  changed.wait (lock, [&] { return done || chunk.full; });
+  if (!chunk.full) return false;
+  consumed++;
+  begin = chunk.data;
+  end = begin + chunk.bytes;
+  return true;
+}
+
+#else
+
+bool Inflater::next (const unsigned char * & begin,
+                     const unsigned char * & end) {
+  Chunk & chunk = chunks[0];
+  chunk.bytes = decompress (chunk.data, chunk_bytes);
+  if (!chunk.bytes) return false;
+  consumed++;
+  begin = chunk.data;
+  end = begin + chunk.bytes;
+  return true;
+}
+
+#endif
+
+}
+
+#endif
@@ -0,0 +1,104 @@
+#ifndef _inflate_hpp_INCLUDED
+#define _inflate_hpp_INCLUDED
+
+#include <cstdio>
+#include <cstddef>
+
+#ifndef NZLIB
+#include <zlib.h>
+#endif
+
+#ifndef NLZMA
+#include <lzma.h>
+#endif
+
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// In-process decompression of 'gzip' compressed files through 'zlib'
+// (unless compiled with '-DNZLIB') and of 'xz' and 'lzma' compressed files
+// through 'liblzma' (unless compiled with '-DNLZMA').  Otherwise 'File'
+// falls back to external decompression helpers through 'popen'.
+
+#if defined(NZLIB) && defined(NLZMA)
+#define NINFLATE
+#endif
+
+#ifndef NINFLATE
+
+namespace CaDiCaL {
+
+// The compressed file is decompressed in chunks.  Unless compiled without
+// thread support ('-DNTHREADS') a separate thread decompresses the next
+// chunk while the parser still reads the current one (double buffering).
+
+class Inflater {
+
+public:
+
+  enum Format { GZIP = 1, XZ = 2, LZMA = 3 };
+
+  Inflater (FILE * compressed, Format);
+  ~Inflater ();
+
+  // Initialize the decoder and start the decompression thread.
+  //
+  bool init ();
+
+  // Get the next chunk of decompressed data.  Returns 'false' at the end
+  // of the compressed file or if decompression failed ('error' non-zero).
+  //
+  bool next (const unsigned char * & begin, const unsigned char * & end);
+
+  const char * error () const { return failed; }
+
+private:
+
+  static const size_t chunk_bytes = 1 << 20;
+  static const size_t input_bytes = 1 << 16;
+
+  FILE * file;          // Compressed input file (closed by 'File').
+  Format format;
+  const char * failed;  // Error message if decompression failed.
+  bool finished;        // Reached end of compressed file.
+  bool ended;           // Last 'gzip' member ended without more data.
+  bool eof;             // Read all compressed input.
+
+#ifndef NZLIB
+  z_stream * zlib;
+#endif
+#ifndef NLZMA
+  lzma_stream * lzma;
+#endif
+
+  unsigned char * input;        // Buffer for compressed input.
+
+  struct Chunk {
+    unsigned char * data;
+    size_t bytes;               // Number of decompressed bytes in 'data'.
+    bool full;                  // Ready to be read by consumer.
+  };
+
+  Chunk chunks[2];
+  unsigned consumed;            // Chunks handed out by 'next' so far.
+
+  size_t decompress (unsigned char * buffer, size_t size);
+
+#ifndef NTHREADS
+  std::thread * producer;
+  std::mutex mutex;
+  std::condition_variable changed;
+  bool stopped;                 // Consumer does not need more chunks.
+  bool done;                    // Producer reached end or failed.
+  void produce ();
+#endif
+};
+
+}
+
+#endif
+
+#endif
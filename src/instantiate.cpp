@@ -24,7 +24,7 @@ Internal::collect_instantiation_candidates (Instantiator & instantiator) {
       Occs & os = occs (lit);
       for (const auto & c : os) {
         if (c->garbage) continue;
-        if (opts.instantiateonce && c->instantiated) continue;
+        if (opts.instantiateonce && cold (c).instantiated) continue;
         if (c->size < opts.instantiateclslim) continue;
         bool satisfied = false;
         int unassigned = 0;
@@ -73,18 +73,19 @@ bool Internal::inst_propagate () {      // Adapted from 'propagate'.
       const signed char b = val (w.blit);
       if (b > 0) continue;
       if (w.binary ()) {
-        if (b < 0) { ok = false; LOG (w.clause, "conflict"); break; }
+        if (b < 0) { ok = false; LOG (w.clause (), "conflict"); break; }
         else inst_assign (w.blit);
       } else {
-        literal_iterator lits = w.clause->begin ();
+        Clause * c = w.clause ();
+        literal_iterator lits = c->begin ();
         const int other = lits[0]^lits[1]^lit;
         lits[0] = other, lits[1] = lit;
         const signed char u = val (other);
         if (u > 0) j[-1].blit = other;
         else {
-          const int size = w.clause->size;
+          const int size = c->size;
           const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const literal_iterator middle = lits + c->pos;
           literal_iterator k = middle;
           signed char v = -1;
           int r = 0;
@@ -92,19 +93,19 @@ bool Internal::inst_propagate () {      // Adapted from 'propagate'.
             k++;
           if (v < 0) {
             k = lits + 2;
-            assert (w.clause->pos <= size);
+            assert (c->pos <= size);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          c->pos = k - lits;
+          assert (lits + 2 <= k), assert (k <= c->end ());
           if (v > 0) {
             j[-1].blit = r;
           } else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
+            LOG (c, "unwatch %d in", r);
             lits[1] = r;
             *k = lit;
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
             j--;
           } else if (!u) {
             assert (v < 0);
@@ -112,7 +113,7 @@ bool Internal::inst_propagate () {      // Adapted from 'propagate'.
           } else {
             assert (u < 0);
             assert (v < 0);
-            LOG (w.clause, "conflict");
+            LOG (c, "conflict");
             ok = false;
             break;
           }
@@ -157,7 +158,7 @@ bool Internal::instantiate_candidate (int lit, Clause * c) {
   assert (active (lit));
   LOG (c, "trying to instantiate %d in", lit);
   assert (!c->garbage);
-  c->instantiated = true;
+  cold (c).instantiated = true;
   level++;
   inst_assign (lit);                            // Assume 'lit' to true.
   for (const auto & other : *c) {
@@ -50,9 +50,14 @@ Internal::Internal ()
   lits (this->max_var)
 {
   control.push_back (Level (0, 0));
+  lookahead_cache.valid = false;
+#ifndef NTHREADS
+  lookahead_workers = 0;
+#endif
 }
 
 Internal::~Internal () {
+  lookahead_reset_workers ();
   for (const auto & c : clauses)
     delete_clause (c);
   if (proof) delete proof;
@@ -585,12 +590,15 @@ int Internal::solve (bool preprocess_only) {
   if (preprocess_only) LOG ("internal solving in preprocessing only mode");
   else LOG ("internal solving in full mode");
   init_report_limits ();
-  int res = already_solved ();
+  int res = reuse_assumptions () ? 0 : already_solved ();
   if (!res) res = restore_clauses ();
   if (!res) {
     init_preprocessing_limits ();
     if (!preprocess_only) init_search_limits ();
   }
+  if (!res && level &&
+      (preprocess_only || lim.preprocessing || lim.localsearch))
+    res = already_solved ();
   if (!res) res = preprocess ();
   if (!preprocess_only) {
     if (!res) res = local_search ();
@@ -667,11 +675,13 @@ int Internal::lookahead () {
   START (lookahead);
   assert (!lookingahead);
   lookingahead = true;
+  lookahead_cache.valid = false;
   int tmp = already_solved ();
   if (!tmp) tmp = restore_clauses ();
   int res = 0;
   if (!tmp) res = lookahead_probing ();
   if (res == INT_MIN) res = 0;
+  lookahead_reset_workers ();
   reset_solving ();
   report_solving (tmp);
   assert (lookingahead);
@@ -685,6 +695,7 @@ int Internal::lookahead () {
 void Internal::print_statistics () {
   stats.print (this);
   if (checker) checker->print_stats ();
+  if (tracer) tracer->print_stats ();
 }
 
 /*------------------------------------------------------------------------*/
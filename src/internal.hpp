@@ -14,6 +14,7 @@
 #include <cassert>
 #include <climits>
 #include <cmath>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -52,6 +53,7 @@ extern "C" {
 #include "cadical.hpp"
 #include "checker.hpp"
 #include "clause.hpp"
+#include "clausetable.hpp"
 #include "config.hpp"
 #include "contract.hpp"
 #include "cover.hpp"
@@ -62,11 +64,13 @@ extern "C" {
 #include "flags.hpp"
 #include "format.hpp"
 #include "heap.hpp"
+#include "inflate.hpp"
 #include "instantiate.hpp"
 #include "internal.hpp"
 #include "level.hpp"
 #include "limit.hpp"
 #include "logging.hpp"
+#include "lratbuilder.hpp"
 #include "message.hpp"
 #include "observer.hpp"
 #include "occs.hpp"
@@ -100,6 +104,7 @@ using namespace std;
 
 struct Coveror;
 struct External;
+struct LookaheadWorkers;
 struct Walker;
 
 struct CubesWithStatus {
@@ -198,8 +203,25 @@ struct Internal {
   Reap reap;                    // radix heap for shrink
 
   vector<int> probes;           // remaining scheduled probes
+
+  // Scores of the last complete lookahead probing round, which remain
+  // valid as long as the formula does not change (see 'lookahead.cpp').
+  //
+  struct {
+    bool valid;                 // scores can be reused
+    int64_t fixed, added;       // 'stats.all.fixed' and 'stats.added.total'
+    int active;                 // active variables
+    vector<int> assumed;        // variables assumed (thus not scored)
+  } lookahead_cache;
+  vector<int> lookahead_scores; // implied assignments per literal or '-1'
+#ifndef NTHREADS
+  LookaheadWorkers * lookahead_workers; // for parallel lookahead probing
+#endif
   vector<Level> control;        // 'level + 1 == control.size ()'
   vector<Clause*> clauses;      // ordered collection of all clauses
+#ifdef COLDFLAGS
+  vector<ColdFlags> colds;      // cold flags of clauses (see 'clause.hpp')
+#endif
   Averages averages;            // glue, size, jump moving averages
   Limit lim;                    // limits for various phases
   Last last;                    // statistics at last occurrence
@@ -329,6 +351,22 @@ struct Internal {
   const Flags &
   flags (int lit) const       { return ftab[vidx (lit)]; }
 
+  // Flags of clauses only used during inprocessing (see 'clause.hpp').
+  //
+#ifdef COLDFLAGS
+  ColdFlags & cold (Clause * c) {
+    assert (c->cold < colds.size ());
+    return colds[c->cold];
+  }
+  const ColdFlags & cold (const Clause * c) const {
+    assert (c->cold < colds.size ());
+    return colds[c->cold];
+  }
+#else
+  ColdFlags & cold (Clause * c)             { return c->cold; }
+  const ColdFlags & cold (const Clause * c) const { return c->cold; }
+#endif
+
   bool occurring () const     { return !otab.empty (); }
   bool watching () const      { return !wtab.empty (); }
 
@@ -529,8 +567,14 @@ struct Internal {
   void search_assign_driving (int lit, Clause * reason);
   void search_assume_decision (int decision);
   void assign_unit (int lit);
+  void propagate2 ();
   bool propagate ();
 
+  // Importing clauses from a connected clause source in 'import.cpp'.
+  //
+  void import_clause (const vector<int> & eclause, int glue);
+  void import_clauses ();
+
   // Undo and restart in 'backtrack.cpp'.
   //
   void unassign (int lit);
@@ -604,6 +648,7 @@ struct Internal {
   int backward_true_satisfiable ();
   int positive_horn_satisfiable ();
   int negative_horn_satisfiable ();
+  bool lucky_formula_changed ();
 
   // Asynchronous terminating check.
   //
@@ -642,6 +687,9 @@ struct Internal {
   void update_reason_references ();
   void copy_non_garbage_clauses ();
   void delete_garbage_clauses ();
+#ifdef COLDFLAGS
+  void compact_colds ();
+#endif
   void check_clause_stats ();
   void check_var_stats ();
   bool arenaing ();
@@ -1017,6 +1065,7 @@ struct Internal {
     // is requested from 'External::simplifiy' only preprocessing is called
     // though. This is all orchestrated by the 'solve' function.
     //
+    int reuse_assumptions();
     int already_solved();
     int restore_clauses();
     bool preprocess_round(int round);
@@ -1030,9 +1079,17 @@ struct Internal {
 
     //
     int lookahead();
-    CubesWithStatus generate_cubes(int, int);
+    int generate_cubes(int, int, CubeSink &);
+    bool lookahead_cubes(int, int, int, int, const std::vector<int> &,
+                         CubeSink &);
+    void lookahead_unassume();
+    int lookahead_cube_free();
     int most_occurring_literal();
     int lookahead_probing();
+    void lookahead_probing_in_parallel();
+    void lookahead_reset_workers();
+    bool lookahead_cache_hit();
+    int lookahead_best_probe();
     int lookahead_next_probe();
     void lookahead_flush_probes();
     void lookahead_generate_probes();
@@ -50,6 +50,7 @@ struct Last {
   struct { int64_t conflicts; } reduce, rephase;
   struct { int64_t marked; } ternary;
   struct { int64_t fixed; } collect;
+  struct { int64_t added, removed, fixed; unsigned failed; } lucky;
   Last ();
 };
 
@@ -1,5 +1,12 @@
 #include "internal.hpp"
 
+#ifndef NTHREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 struct literal_occ {
@@ -266,6 +273,359 @@ bool Internal::terminating_asked() {
   return false;
 }
 
+#ifndef NTHREADS
+
+// For parallel lookahead probing ('--lookaheadthreads=<n>' with 'n > 1')
+// the probes are evaluated by several threads.  These threads can neither
+// use the watch lists, which are updated during propagation, nor the
+// global trail and values.  Instead all threads share a read-only copy of
+// the clauses, without root-level satisfied clauses and falsified
+// literals, with occurrence lists in compressed row format.  Each thread
+// propagates probes with its own trail, values and counters of falsified
+// literals per clause.  This counter based propagation does not need to
+// move watches and is complete.
+
+struct LookaheadClauses {
+
+  vector<int> literals;         // Literals of all clauses.
+  vector<unsigned> start;       // Start of clause 'i' in 'literals'.
+  vector<unsigned> offset;      // Start of occurrences of literal.
+  vector<unsigned> occs;        // Occurrences of literals (clause index).
+
+  static unsigned ulit (int lit) { return 2u*abs (lit) + (lit < 0); }
+
+  LookaheadClauses (Internal * internal) {
+    const unsigned size = 2u*(internal->max_var + 1);
+    vector<unsigned> count (size + 1);
+    for (const auto & c : internal->clauses) {
+      if (c->garbage) continue;
+      bool satisfied = false;
+      const size_t before = literals.size ();
+      for (const auto & lit : *c) {
+        const signed char tmp = internal->val (lit);
+        if (tmp > 0) { satisfied = true; break; }
+        if (!tmp) literals.push_back (lit);
+      }
+      if (satisfied || literals.size () - before < 2) {
+        literals.resize (before);
+        continue;
+      }
+      start.push_back (before);
+      for (size_t i = before; i < literals.size (); i++)
+        count[ulit (literals[i])]++;
+    }
+    start.push_back (literals.size ());
+    offset.resize (size + 1);
+    for (unsigned u = 0; u < size; u++)
+      offset[u + 1] = offset[u] + count[u];
+    occs.resize (literals.size ());
+    const unsigned clauses = start.size () - 1;
+    for (unsigned i = 0; i < clauses; i++)
+      for (unsigned j = start[i]; j < start[i + 1]; j++) {
+        const unsigned u = ulit (literals[j]);
+        occs[offset[u + 1] - count[u]--] = i;
+      }
+  }
+};
+
+struct LookaheadProber {
+
+  const LookaheadClauses * clauses;
+  vector<signed char> vals;
+  vector<unsigned> falsified;   // Falsified literals per clause.
+  vector<unsigned> touched;     // Clauses with non-zero 'falsified'.
+  vector<int> trail;
+
+  LookaheadProber () : clauses (0) { }
+
+  void init (const LookaheadClauses * c, int max_var) {
+    clauses = c;
+    vals.assign (2u*(max_var + 1), 0);
+    falsified.assign (c->start.size (), 0);
+  }
+
+  signed char val (int lit) const {
+    return vals[LookaheadClauses::ulit (lit)];
+  }
+
+  void assign (int lit) {
+    vals[LookaheadClauses::ulit (lit)] = 1;
+    vals[LookaheadClauses::ulit (-lit)] = -1;
+    trail.push_back (lit);
+  }
+
+  // Returns the number of assigned literals or '-1' on conflict.
+
+  int probe (int probe) {
+    assert (trail.empty ());
+    assign (probe);
+    bool conflict = false;
+    for (size_t next = 0; !conflict && next < trail.size (); next++) {
+      const unsigned u = LookaheadClauses::ulit (-trail[next]);
+      for (unsigned k = clauses->offset[u];
+           !conflict && k < clauses->offset[u + 1]; k++) {
+        const unsigned i = clauses->occs[k];
+        const unsigned begin = clauses->start[i];
+        const unsigned end = clauses->start[i + 1];
+        if (!falsified[i]) touched.push_back (i);
+        if (++falsified[i] + 1 < end - begin) continue;
+        int unit = 0;
+        bool satisfied = false;
+        for (unsigned j = begin; !satisfied && j < end; j++) {
+          const int lit = clauses->literals[j];
+          const signed char tmp = val (lit);
+          if (tmp > 0) satisfied = true;
+          else if (!tmp) unit = lit;
+        }
+        if (satisfied) continue;
+        if (unit) assign (unit);
+        else conflict = true;
+      }
+    }
+    const int res = conflict ? -1 : (int) trail.size ();
+    for (const auto & lit : trail)
+      vals[LookaheadClauses::ulit (lit)] =
+        vals[LookaheadClauses::ulit (-lit)] = 0;
+    for (const auto & i : touched)
+      falsified[i] = 0;
+    touched.clear ();
+    trail.clear ();
+    return res;
+  }
+};
+
+// Cube generation runs one probing round per cube.  Thus the helper
+// threads are started once (when first needed) and then wait for the next
+// round, until they are stopped at the end of 'generate_cubes' (or
+// 'lookahead').  The snapshot of the clauses is only taken again if units
+// were fixed or clauses were added since the last round (the same keys as
+// for the lookahead score cache), since otherwise it would not change.
+
+struct LookaheadWorkers {
+
+  Internal * internal;
+
+  LookaheadClauses * snapshot;
+  int64_t fixed, added;         // 'stats.all.fixed' and 'stats.added.total'
+  int max_var;                  // of snapshot
+
+  vector<LookaheadProber> probers;  // First is used by calling thread.
+  vector<std::thread> threads;      // Helper threads.
+
+  std::mutex mutex;
+  std::condition_variable wakeup, finished;
+  int64_t round;                // Number of started rounds.
+  size_t working;               // Helper threads busy in current round.
+  bool stopping;
+
+  const vector<int> * candidates;       // Probes of current round.
+  vector<int> * implied;                // Their results.
+  std::atomic<size_t> next;
+  std::atomic<bool> stop;
+
+  LookaheadWorkers (Internal *, size_t threads);
+  ~LookaheadWorkers ();
+
+  void update ();
+  void evaluate (LookaheadProber &, bool calling);
+  void help (size_t);
+  size_t run (const vector<int> & candidates, vector<int> & implied);
+};
+
+LookaheadWorkers::LookaheadWorkers (Internal * i, size_t size)
+:
+  internal (i), snapshot (0), fixed (-1), added (-1), max_var (0),
+  probers (size), round (0), working (0), stopping (false),
+  candidates (0), implied (0), next (0), stop (false)
+{
+  for (size_t t = 1; t < size; t++)
+    threads.push_back (std::thread (&LookaheadWorkers::help, this, t));
+}
+
+LookaheadWorkers::~LookaheadWorkers () {
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    stopping = true;
+  }
+  wakeup.notify_all ();
+  for (auto & thread : threads)
+    thread.join ();
+  delete snapshot;
+}
+
+// Only called in between rounds while all helper threads are waiting.
+
+void LookaheadWorkers::update () {
+  if (snapshot &&
+      fixed == internal->stats.all.fixed &&
+      added == internal->stats.added.total &&
+      max_var == internal->max_var)
+    return;
+  internal->stats.lookaheadsnapshots++;
+  delete snapshot;
+  snapshot = new LookaheadClauses (internal);
+  fixed = internal->stats.all.fixed;
+  added = internal->stats.added.total;
+  max_var = internal->max_var;
+  for (auto & prober : probers)
+    prober.init (snapshot, max_var);
+}
+
+void LookaheadWorkers::evaluate (LookaheadProber & prober, bool calling) {
+  const size_t size = candidates->size ();
+  size_t i;
+  while (!stop && (i = next++) < size) {
+    (*implied)[i] = prober.probe ((*candidates)[i]);
+    if (calling && internal->terminating_asked ()) stop = true;
+  }
+}
+
+void LookaheadWorkers::help (size_t t) {
+  int64_t done = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock (mutex);
+      wakeup.wait (lock, [&] { return stopping || round != done; });
+      if (stopping) return;
+      done = round;
+    }
+    evaluate (probers[t], false);
+    {
+      std::lock_guard<std::mutex> lock (mutex);
+      if (!--working) finished.notify_one ();
+    }
+  }
+}
+
+// Returns the number of evaluated candidates (all unless terminated).
+
+size_t LookaheadWorkers::run (const vector<int> & c, vector<int> & i) {
+  update ();
+  candidates = &c;
+  implied = &i;
+  next = 0;
+  stop = false;
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    working = threads.size ();
+    round++;
+  }
+  wakeup.notify_all ();
+  evaluate (probers[0], true);
+  {
+    std::unique_lock<std::mutex> lock (mutex);
+    finished.wait (lock, [&] { return !working; });
+  }
+  return min ((size_t) next, c.size ());
+}
+
+// All remaining probes are collected and evaluated in parallel, where the
+// calling thread takes part and checks for termination.  Afterwards failed
+// literals are merged sequentially in the original probing order, by
+// propagating them again with the standard probing propagation and then
+// learning the failed literal unit as in sequential lookahead.  The other
+// probes, which are still unassigned, get their number of implied
+// assignments as score.  Hyper binary resolvents are only derived for
+// failed literals though.
+
+void Internal::lookahead_probing_in_parallel () {
+
+  vector<int> candidates;
+  int probe;
+  while ((probe = lookahead_next_probe ())) {
+    propfixed (probe) = stats.all.fixed;
+    candidates.push_back (probe);
+  }
+  if (candidates.empty ()) return;
+
+  const size_t threads = opts.lookaheadthreads;
+  if (lookahead_workers && lookahead_workers->probers.size () != threads)
+    lookahead_reset_workers ();
+  if (!lookahead_workers)
+    lookahead_workers = new LookaheadWorkers (this, threads);
+
+  const int root = trail.size ();
+  vector<int> implied (candidates.size (), 0);
+  const size_t evaluated = lookahead_workers->run (candidates, implied);
+  MSG ("evaluated %zd lookahead probes with %zd threads",
+    evaluated, threads);
+
+  for (size_t i = 0; !unsat && i < evaluated; i++) {
+    if (implied[i] >= 0) continue;
+    const int probe = candidates[i];
+    if (!active (probe)) continue;
+    stats.probed++;
+    probe_assign_decision (probe);
+    if (probe_propagate ()) backtrack ();
+    else failed_literal (probe);
+  }
+
+  for (size_t i = 0; !unsat && i < evaluated; i++) {
+    if (implied[i] < 0) continue;
+    const int probe = candidates[i];
+    if (!active (probe)) continue;
+    stats.probed++;
+    lookahead_scores[vlit (probe)] = root + implied[i];
+  }
+}
+
+#endif
+
+void Internal::lookahead_reset_workers () {
+#ifndef NTHREADS
+  delete lookahead_workers;
+  lookahead_workers = 0;
+#endif
+}
+
+// During cube generation 'lookahead_probing' is called for every cube.
+// Since probing happens on the root level and only excludes the variables
+// of the cube, its scores, i.e., the number of implied assignments of each
+// probe, only change if the formula changed, that is new units were
+// found, clauses were added (for instance hyper binary resolvents) or
+// variables were substituted.  Otherwise we reuse the scores of the last
+// complete probing round and just pick the best literal not in the cube,
+// instead of decomposing, running ternary resolution and probing again.
+// Variables assumed during that round were not probed and thus have no
+// score.  Therefore all of them have to be assumed still, which holds for
+// all cubes below the cube for which the round was run.
+
+bool Internal::lookahead_cache_hit () {
+  if (!opts.lookaheadcache) return false;
+  if (!lookahead_cache.valid) return false;
+  if (lookahead_cache.fixed != stats.all.fixed) return false;
+  if (lookahead_cache.added != stats.added.total) return false;
+  if (lookahead_cache.active != active ()) return false;
+  for (const auto & idx : lookahead_cache.assumed)
+    if (!assumed (idx) && !assumed (-idx)) return false;
+  return true;
+}
+
+// Both after a probing round and with cached scores the splitting literal
+// is the active literal not in the cube with the highest score, where ties
+// are broken by 'bumped' and then by the variable index (negative literal
+// first).  If there is no scored literal we fall back to the most
+// occurring literal.
+
+int Internal::lookahead_best_probe () {
+  int res = 0, max_hbrs = -1;
+  for (int idx = 1; idx <= max_var; idx++) {
+    if (!active (idx) || assumed (idx) || assumed (-idx)) continue;
+    for (int sign = -1; sign <= 1; sign += 2) {
+      const int lit = sign * idx;
+      const int hbrs = lookahead_scores[vlit (lit)];
+      if (hbrs < 0) continue;
+      if (max_hbrs < hbrs ||
+          (max_hbrs == hbrs && bumped (lit) > bumped (res))) {
+        res = lit;
+        max_hbrs = hbrs;
+      }
+    }
+  }
+  if (!res) res = most_occurring_literal ();
+  return res;
+}
+
 // We run probing on all literals with some differences:
 //
 // * no limit on the number of propagations. We rely on terminating to stop()
@@ -290,6 +650,7 @@ int Internal::lookahead_probing() {
   int64_t old_probed = stats.probed;
 #endif
   int64_t old_hbrs = stats.hbrs;
+  int res;
 
   if (unsat) return INT_MIN;
   if (level) backtrack ();
@@ -302,6 +663,15 @@ int Internal::lookahead_probing() {
   if (terminating_asked())
     return most_occurring_literal();
 
+  stats.lookaheads++;
+
+  if (lookahead_cache_hit ()) {
+    stats.lookaheadcached++;
+    res = lookahead_best_probe ();
+    MSG ("cached lookahead literal %d", res);
+    return res;
+  }
+
   decompose ();
 
   if (ternary ())       // If we derived a binary clause
@@ -327,32 +697,31 @@ int Internal::lookahead_probing() {
   propagated = propagated2 = trail.size ();
 
   int probe;
-  int res = most_occurring_literal();
-  int max_hbrs = -1;
+
+  lookahead_scores.assign (2u*(max_var + 1), -1);
 
   set_mode (PROBE);
 
   MSG("unsat = %d, terminating_asked () = %d ", unsat, terminating_asked ());
+#ifndef NTHREADS
+  if (opts.lookaheadthreads > 1 && !unsat && !terminating_asked ())
+    lookahead_probing_in_parallel ();
+  else
+#endif
   while (!unsat &&
          !terminating_asked () &&
          (probe = lookahead_next_probe ())) {
     stats.probed++;
-    int hbrs;
-
     probe_assign_decision (probe);
-    if (probe_propagate ())
-      hbrs = trail.size(), backtrack();
-    else hbrs = 0, failed_literal (probe);
-    if (max_hbrs < hbrs ||
-        (max_hbrs == hbrs &&
-         internal->bumped(probe) > internal->bumped(res))) {
-      res = probe;
-      max_hbrs = hbrs;
-    }
+    if (probe_propagate ()) {
+      lookahead_scores[vlit (probe)] = trail.size ();
+      backtrack ();
+    } else failed_literal (probe);
   }
 
   reset_mode (PROBE);
 
+  res = 0;
   if (unsat) {
     MSG ("probing derived empty clause");
     res = INT_MIN;
@@ -367,6 +736,19 @@ int Internal::lookahead_probing() {
     } else sort_watches ();
   }
 
+  if (res != INT_MIN) {
+    res = lookahead_best_probe ();
+    if (!terminating_asked ()) {
+      lookahead_cache.valid = true;
+      lookahead_cache.fixed = stats.all.fixed;
+      lookahead_cache.added = stats.added.total;
+      lookahead_cache.active = active ();
+      lookahead_cache.assumed.clear ();
+      for (const auto & lit : assumptions)
+        lookahead_cache.assumed.push_back (abs (lit));
+    }
+  }
+
 #ifndef QUIET
   int failed = stats.failed - old_failed;
   int64_t probed = stats.probed - old_probed;
@@ -382,19 +764,123 @@ int Internal::lookahead_probing() {
     PHASE ("lookahead-probe-round", stats.probingrounds,
       "found %" PRId64 " hyper binary resolvents", hbrs);
 
-  MSG ("lookahead literal %d with %d\n", res, max_hbrs);
+  MSG ("lookahead literal %d\n", res);
 
   return res;
 }
 
-CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
+// Cubes are generated depth-first and each cube is passed to the sink as
+// soon as it is final, i.e., it reached the maximum depth, there is no
+// literal left to split on, or termination was requested after reaching
+// the minimum depth.  Thus only the current cube is kept and not all cubes
+// of a level of the cube tree.  The current cube is the stack of
+// assumptions, which is extended by one assumption going down in the cube
+// tree and shrunken by one assumption going back up.  Since lookahead
+// probing happens on the root level, the assumptions are only used to
+// exclude their variables from being split on again.  If 'unsat' is
+// derived on the way the whole formula is unsatisfiable and we stop.
+
+void Internal::lookahead_unassume () {
+  assert (!assumptions.empty ());
+  const int lit = assumptions.back ();
+  Flags & f = flags (lit);
+  const unsigned char bit = bign (lit);
+  f.assumed &= ~bit;
+  f.failed &= ~bit;
+  melt (lit);
+  assumptions.pop_back ();
+  LOG ("unassumed %d", lit);
+}
+
+// Instead of splitting every cube up to the maximum depth, cube
+// generation can also stop splitting a cube as soon as propagating its
+// literals leaves at most 'opts.lookaheadfree' percent of the variables,
+// which were active at the start of cube generation, unassigned (similar
+// to the cutoff in 'march_cu').  This yields more balanced cubes than a
+// fixed depth.  The cube literals are propagated as decisions in a
+// temporary search assignment.  A conflicting cube has zero free variables
+// and thus becomes a (trivially unsatisfiable) leaf cube too.
+
+int Internal::lookahead_cube_free () {
+  assert (!level);
+  assert (propagated == trail.size ());
+  const size_t before = trail.size ();
+  bool failed = false;
+  for (const auto & lit : assumptions) {
+    const signed char tmp = val (lit);
+    if (tmp > 0) continue;
+    if (tmp < 0) { failed = true; break; }
+    search_assume_decision (lit);
+    if (!propagate ()) { failed = true; break; }
+  }
+  const int res = failed ? 0 : active () - (int) (trail.size () - before);
+  if (level) backtrack ();
+  if (conflict) conflict = 0;
+  LOG ("cube of size %zd leaves %d variables free",
+    assumptions.size (), res);
+  return res;
+}
+
+bool Internal::lookahead_cubes (int depth, int min_depth, int cube_level,
+                                int cutoff, const std::vector<int> &loccs,
+                                CubeSink &sink) {
+  assert(non_tautological_cube(assumptions));
+  auto leaf = [&]() {
+    stats.cubes++;
+    return sink.cube(assumptions);
+  };
+
+  propagate();
+  if (unsat) {
+    LOG("root level propagation failed; formula is unsat");
+    return false;
+  }
+
+  if (cube_level == depth)
+    return leaf();
+
+  const bool terminating = terminating_asked();
+  if (terminating && cube_level >= min_depth)
+    return leaf();
+
+  if (cutoff && cube_level > 0 && cube_level >= min_depth &&
+      lookahead_cube_free() <= cutoff) {
+    LOG("cube below cutoff of %d free variables", cutoff);
+    stats.cutoffcubes++;
+    return leaf();
+  }
+
+  int res = terminating ? lookahead_locc(loccs) : lookahead_probing();
+  if (unsat) {
+    LOG("lookahead probing derived the empty clause");
+    return false;
+  }
+
+  if (res == 0) {
+    LOG("no lit to split %i", res);
+    return leaf();
+  }
+
+  LOG("splitting on lit %i at cube level %d", res, cube_level);
+  for (int sign = 1; sign >= -1; sign -= 2) {
+    assume(sign * res);
+    const bool ok = lookahead_cubes(depth, min_depth, cube_level + 1,
+                                    cutoff, loccs, sink);
+    lookahead_unassume();
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
+int Internal::generate_cubes(int depth, int min_depth, CubeSink &sink) {
   if (!active() || depth == 0) {
-    CubesWithStatus cubes;
-    cubes.cubes.push_back(std::vector<int>());
-    return cubes;
+    sink.cube(std::vector<int>());
+    return 0;
   }
 
   lookingahead = true;
+  lookahead_cache.valid = false;
   START(lookahead);
   MSG("Generating cubes of depth %i", depth);
 
@@ -405,100 +891,43 @@ CubesWithStatus Internal::generate_cubes(int depth, int min_depth) {
   if (res == 0)
    res = restore_clauses();
   if(unsat)
-    res = 10;
+    res = 20;
   if (res != 0)
     res = solve(true);
   if (res != 0) {
     MSG("Solved during preprocessing");
-    CubesWithStatus cubes;
-    cubes.status = res;
-    cubes.status = 20;
     lookingahead = false;
     STOP(lookahead);
-    return cubes;
+    return res;
   }
 
   reset_limits();
   MSG ("generate cubes with %zu assumptions\n", assumptions.size());
 
   assert(ntab.empty());
-  std::vector<int> current_assumptions{assumptions};
-  std::vector<std::vector<int>> cubes {{assumptions}};
+#ifndef NDEBUG
+  const size_t assumed = assumptions.size();
+#endif
   auto loccs{lookahead_populate_locc()};
   LOG("loccs populated\n");
   assert(ntab.empty());
 
-  for (int i = 0; i < depth; ++i) {
-    LOG("Probing at depth %i, currently %zu have been generated",
-        i, cubes.size());
-    std::vector<std::vector<int>> cubes2 {std::move(cubes)};
-    cubes.clear ();
-
-    for (size_t j = 0; j < cubes2.size(); ++j) {
-      assert(ntab.empty());
-      assert(!unsat);
-      reset_assumptions();
-      for (auto lit : cubes2[j])
-        assume(lit);
-      restore_clauses();
-      propagate();
-        // preprocess_round(0); //uncomment maybe
-
-      if (unsat) {
-        LOG("current cube is unsat; skipping");
-        unsat = false;
-        continue;
-      }
-
-      int res = terminating_asked()  ? lookahead_locc(loccs) : lookahead_probing();
-      if(unsat) {
-        LOG("current cube is unsat; skipping");
-        unsat = false;
-        continue;
-      }
-
-      if (res == 0) {
-        LOG("no lit to split %i", res);
-        cubes.push_back(cubes2[j]);
-        continue;
-      }
-
-      assert(res != 0);
-      LOG("splitting on lit %i", res);
-      std::vector<int> cube1{cubes2[j]};
-      cube1.push_back(res);
-      std::vector<int> cube2{std::move(cubes2[j])};
-      cube2.push_back(-res);
-      cubes.push_back(cube1);
-      cubes.push_back(cube2);
-    }
-
-    if (terminating_asked() && i >= min_depth)
-      break;
-  }
-
-  assert(std::for_each(std::begin(cubes), std::end(cubes), [](std::vector<int> cube){return non_tautological_cube (cube);}));
-  reset_assumptions();
-
-  for(auto lit : current_assumptions)
-    assume(lit);
+  const int cutoff = (int64_t) opts.lookaheadfree * active() / 100;
+  if (cutoff)
+    MSG ("cutting off cubes with at most %d free variables", cutoff);
+  lookahead_cubes(depth, min_depth, 0, cutoff, loccs, sink);
+  assert(assumptions.size() == assumed);
+  lookahead_reset_workers ();
 
   STOP(lookahead);
   lookingahead = false;
 
   if (unsat) {
     LOG("Solved during preprocessing");
-    CubesWithStatus cubes;
-    cubes.status = 20;
-    cubes.status = res;
-    return cubes;
+    return 20;
   }
 
-  CubesWithStatus rcubes;
-  rcubes.status = 0;
-  rcubes.cubes = cubes;
-
-  return rcubes;
+  return 0;
 }
 
 } // namespace CaDiCaL
@@ -0,0 +1,591 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+inline unsigned LratBuilder::l2u (int lit) {
+   assert (lit);
+   assert (lit != INT_MIN);
+   unsigned res = 2*(abs (lit) - 1);
+   if (lit < 0) res++;
+   return res;
+}
+
+inline signed char LratBuilder::val (int lit) {
+  const unsigned u = l2u (lit);
+  assert (u < vals.size ());
+  assert (vals[u] == -vals[u^1]);
+  return vals[u];
+}
+
+inline signed char & LratBuilder::mark (int lit) {
+  const unsigned u = l2u (lit);
+  assert (u < marks.size ());
+  return marks[u];
+}
+
+inline LratWatcher & LratBuilder::watcher (int lit) {
+  const unsigned u = l2u (lit);
+  assert (u < watchers.size ());
+  return watchers[u];
+}
+
+inline LratClause * LratBuilder::clause (uint64_t ref) {
+  assert (ref > ClauseTable::removed);
+  return (LratClause *) (uintptr_t) ref;
+}
+
+/*------------------------------------------------------------------------*/
+
+LratClause * LratBuilder::new_clause (uint64_t id) {
+  const size_t size = simplified.size ();
+  assert (size > 0), assert (size <= UINT_MAX);
+  const size_t bytes = sizeof (LratClause) + (size - 1) * sizeof (int);
+  LratClause * res = (LratClause *) new char [bytes];
+  res->next = 0;
+  res->id = id;
+  res->garbage = false;
+  res->reason = false;
+  res->size = size;
+  int * literals = res->literals, * p = literals;
+  for (const auto & lit : simplified)
+    *p++ = lit;
+  return res;
+}
+
+void LratBuilder::delete_clause (LratClause * c) {
+  if (c->garbage) {
+    assert (num_garbage);
+    num_garbage--;
+  }
+  delete [] (char*) c;
+}
+
+// First two literals are used as watches and should not be false.
+
+void LratBuilder::watch_clause (LratClause * c) {
+  const unsigned size = c->size;
+  assert (size > 1);
+  int * literals = c->literals;
+  for (unsigned i = 0; i < 2; i++) {
+    int lit = literals[i];
+    if (!val (lit)) continue;
+    for (unsigned j = i + 1; j < size; j++) {
+      int other = literals[j];
+      if (val (other)) continue;
+      swap (literals[i], literals[j]);
+      break;
+    }
+  }
+  assert (!val (literals [0]));
+  assert (!val (literals [1]));
+  watcher (literals[0]).push_back (LratWatch (literals[1], c));
+  watcher (literals[1]).push_back (LratWatch (literals[0], c));
+}
+
+// As in the checker we delay removing deleted clauses from watch lists
+// until enough of them accumulated to avoid quadratic behaviour.
+
+void LratBuilder::collect_garbage_clauses () {
+
+  stats.collections++;
+
+  LOG ("LRAT collecting %" PRIu64 " garbage clauses %.0f%%",
+    num_garbage, percent (num_garbage, table.clauses ()));
+
+  for (auto & ws : watchers) {
+    const auto end = ws.end ();
+    auto j = ws.begin (), i = j;
+    for (;i != end; i++) {
+      LratWatch & w = *i;
+      if (!w.clause->garbage) *j++ = w;
+    }
+    if (j == ws.end ()) continue;
+    if (j == ws.begin ()) erase_vector (ws);
+    else ws.resize (j - ws.begin ());
+  }
+
+  for (LratClause * c = garbage, * next; c; c = next)
+    next = c->next, delete_clause (c);
+
+  assert (!num_garbage);
+  garbage = 0;
+}
+
+/*------------------------------------------------------------------------*/
+
+LratBuilder::LratBuilder (Internal * i, Tracer * t)
+:
+  internal (i), tracer (t),
+  size_vars (0),
+  inconsistent (false), num_garbage (0), garbage (0),
+  root (0), next_to_propagate (0), materialized (0),
+  last_id (0), deferring (true), num_provisional (0)
+{
+  LOG ("LRAT new");
+
+  memset (&stats, 0, sizeof (stats));           // Initialize statistics.
+}
+
+LratBuilder::~LratBuilder () {
+  LOG ("LRAT delete");
+  for (uint64_t i = 0; i < table.size (); i++)
+    if (table.occupied (i)) delete_clause (clause (table.ref (i)));
+  for (LratClause * c = garbage, * next; c; c = next)
+    next = c->next, delete_clause (c);
+}
+
+/*------------------------------------------------------------------------*/
+
+void LratBuilder::enlarge_vars (int64_t idx) {
+  assert (0 < idx), assert (idx <= INT_MAX);
+  int64_t new_size_vars = size_vars ? 2*size_vars : 2;
+  while (idx >= new_size_vars) new_size_vars *= 2;
+  LOG ("LRAT enlarging variables from %" PRId64 " to %" PRId64 "",
+    size_vars, new_size_vars);
+  vals.resize (2*new_size_vars);
+  marks.resize (2*new_size_vars);
+  watchers.resize (2*new_size_vars);
+  seen.resize (new_size_vars);
+  reasons.resize (new_size_vars);
+  size_vars = new_size_vars;
+}
+
+void LratBuilder::import_clause (const vector<int> & c) {
+  for (const auto & lit : c) {
+    assert (lit);
+    assert (lit != INT_MIN);
+    int idx = abs (lit);
+    if (idx >= size_vars) enlarge_vars (idx);
+    simplified.push_back (lit);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Literals are only marked if there is a clause with the same hash value
+// and size.  Different from the checker satisfied clauses are kept in the
+// table, since deleting them needs to find them.
+
+uint64_t LratBuilder::find () {
+  const unsigned size = simplified.size ();
+  bool marked = false;
+  const uint64_t res =
+    table.find (table.hash (simplified), [&] (uint64_t ref) {
+      const LratClause * c = clause (ref);
+      if (c->size != size) return false;
+      if (!marked) {
+        for (const auto & lit : simplified) mark (lit) = true;
+        marked = true;
+      }
+      bool found = true;
+      const int * literals = c->literals;
+      for (unsigned i = 0; found && i != size; i++)
+        found = mark (literals[i]);
+      return found;
+    });
+  if (marked)
+    for (const auto & lit : simplified) mark (lit) = false;
+  return res;
+}
+
+LratClause * LratBuilder::insert (uint64_t id) {
+  LratClause * c = new_clause (id);
+  table.insert (table.hash (simplified), (uint64_t) (uintptr_t) c);
+  return c;
+}
+
+/*------------------------------------------------------------------------*/
+
+inline void LratBuilder::assign (int lit, LratClause * reason) {
+  assert (!val (lit));
+  const unsigned u = l2u (lit);
+  vals[u] = 1;
+  vals[u^1] = -1;
+  reasons[abs (lit)] = reason;
+  trail.push_back (lit);
+}
+
+void LratBuilder::backtrack (unsigned previously_propagated) {
+  assert (previously_propagated <= trail.size ());
+  while (trail.size () > previously_propagated) {
+    int lit = trail.back ();
+    const unsigned u = l2u (lit);
+    assert (vals[u] > 0);
+    vals[u] = vals[u^1] = 0;
+    reasons[abs (lit)] = 0;
+    trail.pop_back ();
+  }
+  next_to_propagate = previously_propagated;
+}
+
+// Same propagation as in the checker, except that clauses deleted in the
+// proof are never used (not even binary clauses), since the LRAT checker
+// would not accept their identifiers as hints.
+
+LratClause * LratBuilder::propagate () {
+  LratClause * res = 0;
+  while (!res && next_to_propagate < trail.size ()) {
+    int lit = trail[next_to_propagate++];
+    stats.propagations++;
+    assert (val (lit) > 0);
+    LratWatcher & ws = watcher (-lit);
+    const auto end = ws.end ();
+    auto j = ws.begin (), i = j;
+    for (; !res && i != end; i++) {
+      LratWatch & w = *j++ = *i;
+      const int blit = w.blit;
+      assert (blit != -lit);
+      const signed char blit_val = val (blit);
+      if (blit_val > 0) continue;
+      LratClause * c = w.clause;
+      if (c->garbage) { j--; continue; }
+      const unsigned size = c->size;
+      int * lits = c->literals;
+      int other = lits[0]^lits[1]^(-lit);
+      assert (other != -lit);
+      signed char other_val = val (other);
+      if (other_val > 0) { j[-1].blit = other; continue; }
+      lits[0] = other, lits[1] = -lit;
+      unsigned k;
+      int replacement = 0;
+      signed char replacement_val = -1;
+      for (k = 2; k < size; k++)
+        if ((replacement_val = val (replacement = lits[k])) >= 0)
+          break;
+      if (replacement_val >= 0) {
+        watcher (replacement).push_back (LratWatch (-lit, c));
+        swap (lits[1], lits[k]);
+        j--;
+      } else if (!other_val) assign (other, c);
+      else res = c;
+    }
+    while (i != end) *j++ = *i++;
+    ws.resize (j - ws.begin ());
+  }
+  return res;
+}
+
+// Propagate new root-level units and pin their reasons (they are replaced
+// by derived unit clauses before they can be deleted).
+
+void LratBuilder::propagate_root () {
+  assert (!inconsistent);
+  assert (root <= next_to_propagate);
+  LratClause * conflict = propagate ();
+  for (unsigned i = root; i < trail.size (); i++)
+    reasons[abs (trail[i])]->reason = true;
+  root = trail.size ();
+  if (conflict) add_empty_clause (conflict);
+}
+
+/*------------------------------------------------------------------------*/
+
+uint64_t LratBuilder::new_id () {
+  if (deferring) return provisional + ++num_provisional;
+  return ++last_id;
+}
+
+inline uint64_t LratBuilder::final_id (uint64_t id) {
+  if (id < provisional) return id;
+  assert (!deferring);
+  return last_id - num_provisional + (id - provisional);
+}
+
+// While deferring, lines are encoded as '[id, size, literals..., hints...]'
+// with zero 'size' and no literals for deletions and provisional 'id' and
+// hints are mapped to final identifiers when written.  The literals of
+// added clauses are stored shifted by one to distinguish the empty
+// clause.
+
+void LratBuilder::defer (uint64_t id, const vector<int> * literals,
+                         const vector<uint64_t> * antecedents) {
+  deferred.push_back (id);
+  if (!literals) { deferred.push_back (0); return; }
+  deferred.push_back (literals->size () + 1);
+  for (const auto & lit : *literals)
+    deferred.push_back ((uint64_t) (int64_t) lit);
+  deferred.push_back (antecedents->size ());
+  for (const auto & hint : *antecedents)
+    deferred.push_back (hint);
+}
+
+void LratBuilder::add (uint64_t id,
+                       const vector<int> & literals,
+                       const vector<uint64_t> & antecedents) {
+  stats.hints += antecedents.size ();
+  if (deferring) defer (id, &literals, &antecedents);
+  else tracer->add_lrat_clause (id, literals, antecedents);
+}
+
+void LratBuilder::remove (uint64_t id) {
+  if (deferring) defer (id, 0, 0);
+  else tracer->delete_lrat_clause (last_id, id);
+}
+
+// Provisional identifiers become final after the last original clause.
+
+void LratBuilder::flush_deferred () {
+  assert (deferring);
+  deferring = false;
+  last_id += num_provisional;
+  LOG ("LRAT flushing %" PRIu64 " deferred lines", num_provisional);
+  uint64_t current = last_id - num_provisional;
+  for (uint64_t i = 0; i < table.size (); i++)
+    if (table.occupied (i)) {
+      LratClause * c = clause (table.ref (i));
+      c->id = final_id (c->id);
+    }
+  vector<int> literals;
+  vector<uint64_t> antecedents;
+  const auto end = deferred.end ();
+  auto p = deferred.begin ();
+  while (p != end) {
+    const uint64_t id = final_id (*p++);
+    const uint64_t size = *p++;
+    if (!size) { tracer->delete_lrat_clause (current, id); continue; }
+    literals.clear ();
+    for (uint64_t k = 1; k < size; k++)
+      literals.push_back ((int) (int64_t) *p++);
+    antecedents.clear ();
+    const uint64_t num_hints = *p++;
+    for (uint64_t k = 0; k < num_hints; k++)
+      antecedents.push_back (final_id (*p++));
+    tracer->add_lrat_clause (id, literals, antecedents);
+    current = id;
+  }
+  erase_vector (deferred);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Derive unit clauses for the root-level literals on the trail before
+// 'upto', whose reason is not a unit clause yet.  Their other literals
+// are falsified by earlier root-level literals which already have units.
+
+void LratBuilder::materialize (unsigned upto) {
+  assert (upto <= root);
+  while (materialized < upto) {
+    const int lit = trail[materialized++];
+    const int idx = abs (lit);
+    LratClause * reason = reasons[idx];
+    assert (reason), assert (reason->reason);
+    if (reason->size == 1) continue;
+    unit_hints.clear ();
+    for (unsigned i = 0; i < reason->size; i++) {
+      const int other = reason->literals[i];
+      if (other == lit) continue;
+      LratClause * unit_reason = reasons[abs (other)];
+      assert (unit_reason), assert (unit_reason->size == 1);
+      unit_hints.push_back (unit_reason->id);
+    }
+    unit_hints.push_back (reason->id);
+    const uint64_t id = new_id ();
+    unit_clause.clear ();
+    unit_clause.push_back (lit);
+    LOG (unit_clause, "LRAT deriving root-level unit %" PRIu64, id);
+    add (id, unit_clause, unit_hints);
+    stats.units++;
+    reason->reason = false;
+    simplified.swap (unit_clause);
+    LratClause * c = insert (id);
+    simplified.swap (unit_clause);
+    c->reason = true;
+    reasons[idx] = c;
+  }
+}
+
+// All literals of the root-level conflict have unit reasons after
+// materializing the whole root-level trail.
+
+void LratBuilder::add_empty_clause (LratClause * conflict) {
+  assert (!inconsistent);
+  materialize (root);
+  unit_hints.clear ();
+  for (unsigned i = 0; i < conflict->size; i++) {
+    LratClause * unit_reason = reasons[abs (conflict->literals[i])];
+    assert (unit_reason), assert (unit_reason->size == 1);
+    unit_hints.push_back (unit_reason->id);
+  }
+  unit_hints.push_back (conflict->id);
+  derive_empty_clause ();
+}
+
+void LratBuilder::derive_empty_clause () {
+  unit_clause.clear ();
+  const uint64_t id = new_id ();
+  LOG ("LRAT deriving empty clause %" PRIu64, id);
+  add (id, unit_clause, unit_hints);
+  inconsistent = true;
+}
+
+// Assume the negation of 'simplified', propagate until a conflict is
+// found and collect the reasons of all literals the conflict depends on
+// by traversing the trail backward.  Literals of the clause itself are
+// assumed and thus need no reason.  Reversing the collected reasons gives
+// the order in which the LRAT checker finds them to become unit.
+
+bool LratBuilder::derive () {
+  assert (!inconsistent);
+  assert (root == trail.size ());
+  for (const auto & lit : simplified)
+    if (!val (lit)) assign (-lit, 0);
+  LratClause * conflict = propagate ();
+  if (!conflict) { backtrack (root); return false; }
+  assert (touched.empty ());
+  for (const auto & lit : simplified) {
+    const int idx = abs (lit);
+    seen[idx] = 2;
+    touched.push_back (idx);
+  }
+  hints.clear ();
+  for (unsigned i = 0; i < conflict->size; i++) {
+    const int idx = abs (conflict->literals[i]);
+    if (seen[idx]) continue;
+    seen[idx] = 1;
+    touched.push_back (idx);
+  }
+  for (unsigned i = trail.size (); i--; ) {
+    const int lit = trail[i];
+    const int idx = abs (lit);
+    if (seen[idx] != 1) continue;
+    if (i < root) {
+      if (materialized <= i) materialize (i + 1);
+      assert (reasons[idx]->size == 1);
+      hints.push_back (reasons[idx]->id);
+      continue;
+    }
+    LratClause * reason = reasons[idx];
+    assert (reason);
+    hints.push_back (reason->id);
+    for (unsigned j = 0; j < reason->size; j++) {
+      const int other = abs (reason->literals[j]);
+      if (seen[other]) continue;
+      seen[other] = 1;
+      touched.push_back (other);
+    }
+  }
+  for (const auto & idx : touched) seen[idx] = 0;
+  touched.clear ();
+  reverse (hints.begin (), hints.end ());
+  hints.push_back (conflict->id);
+  backtrack (root);
+  return true;
+}
+
+// Save the clause and update the root-level assignment.  Satisfied clauses
+// are never needed as hints and thus not kept.
+
+void LratBuilder::add_clause (uint64_t id) {
+  if (simplified.empty ()) {
+    unit_hints.clear ();
+    unit_hints.push_back (id);
+    derive_empty_clause ();
+    return;
+  }
+  int unit = 0;
+  for (const auto & lit : simplified) {
+    const signed char tmp = val (lit);
+    if (tmp > 0) return;
+    if (tmp < 0) continue;
+    if (!unit) unit = lit;
+    else unit = INT_MIN;
+  }
+  LratClause * c = insert (id);
+  if (!unit) add_empty_clause (c);
+  else if (unit != INT_MIN) {
+    assign (unit, c);
+    propagate_root ();
+  } else watch_clause (c);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Original clauses need to be numbered even after the empty clause was
+// derived, since the following identifiers have to be fresh.
+
+void LratBuilder::add_original_clause (const vector<int> & c) {
+  const uint64_t id = ++last_id;
+  if (inconsistent) return;
+  START (lrat);
+  LOG (c, "LRAT addition of original clause");
+  stats.original++;
+  import_clause (c);
+  if (ClauseTable::normalize (simplified))
+    LOG ("LRAT ignoring tautological original clause %" PRIu64, id);
+  else add_clause (id);
+  simplified.clear ();
+  STOP (lrat);
+}
+
+void LratBuilder::add_derived_clause (const vector<int> & c) {
+  if (inconsistent) return;
+  START (lrat);
+  if (deferring && internal->original.empty ()) flush_deferred ();
+  LOG (c, "LRAT addition of derived clause");
+  stats.derived++;
+  import_clause (c);
+  bool satisfied = false;
+  for (const auto & lit : simplified)
+    if (val (lit) > 0) satisfied = true;
+  if (satisfied || ClauseTable::normalize (simplified))
+    LOG ("LRAT ignoring satisfied or tautological derived clause");
+  else if (!derive ()) {
+    fatal_message_start ();
+    fputs ("failed to derive LRAT hints of clause:\n", stderr);
+    for (const auto & lit : c)
+      fprintf (stderr, "%d ", lit);
+    fputc ('0', stderr);
+    fatal_message_end ();
+  } else {
+    const uint64_t id = new_id ();
+    add (id, simplified, hints);
+    add_clause (id);
+  }
+  simplified.clear ();
+  STOP (lrat);
+}
+
+// Reasons of root-level literals are replaced by derived units first.
+// Unit clauses which are reasons and the conflict clause are kept.
+
+void LratBuilder::delete_clause (const vector<int> & c) {
+  if (inconsistent) return;
+  START (lrat);
+  if (deferring && internal->original.empty ()) flush_deferred ();
+  LOG (c, "LRAT deletion of clause");
+  import_clause (c);
+  uint64_t pos;
+  if (!ClauseTable::normalize (simplified) &&
+      (pos = find ()) != table.size ()) {
+    LratClause * d = clause (table.ref (pos));
+    if (d->reason && d->size > 1) {
+      materialize (root);               // might resize hash table
+      pos = find ();
+      assert (pos != table.size ());
+      d = clause (table.ref (pos));
+      assert (!d->reason);
+    }
+    if (!d->reason) {
+      stats.deleted++;
+      remove (d->id);
+      num_garbage++;
+      table.remove (pos);
+      d->next = garbage;
+      garbage = d;
+      d->garbage = true;
+      if (num_garbage > 0.5 * max ((size_t) table.clauses (),
+                                   (size_t) size_vars))
+        collect_garbage_clauses ();
+    }
+  }
+  simplified.clear ();
+  STOP (lrat);
+}
+
+void LratBuilder::finish () {
+  if (deferring) flush_deferred ();
+}
+
+}
@@ -0,0 +1,173 @@
+#ifndef _lratbuilder_hpp_INCLUDED
+#define _lratbuilder_hpp_INCLUDED
+
+/*------------------------------------------------------------------------*/
+
+namespace CaDiCaL {
+
+class Tracer;
+
+/*------------------------------------------------------------------------*/
+
+// The LRAT builder turns the clausal (DRUP) proof of the solver into an
+// LRAT proof, where every clause has a unique identifier and each derived
+// clause lists the identifiers of its antecedents ('hints') in the order
+// in which they become unit (or falsified for the last one) after
+// assuming the negation of the derived clause.  Checking such a proof
+// does not require any search and thus takes linear time.
+//
+// Instead of threading clause identifiers through conflict analysis,
+// minimization and all the inprocessing procedures, the builder keeps
+// its own copy of the clauses (with identifiers, found through a
+// 'ClauseTable') similar to the online proof 'Checker' and derives the
+// antecedents of a clause by unit propagation on its negation followed by
+// a backward traversal of the resulting implication graph, which yields
+// exactly the reason clauses conflict analysis has used (including
+// minimization) or fewer.
+//
+// Root-level assignments are kept forever.  Their reasons are turned into
+// derived unit clauses lazily (in trail order) as soon they are needed as
+// hints or their reason clause is deleted, so that hints of later clauses
+// only need to refer to a single unit clause for each root-level literal.
+//
+// Original clauses are numbered in the order they are added, starting
+// with one, which matches the numbering of clauses in the DIMACS file the
+// LRAT checker reads.  However, the solver already derives (shortened)
+// clauses while original clauses are still added.  Lines derived during
+// this phase are kept back and get their final identifiers after the last
+// original clause as soon the first clause is derived or deleted outside
+// of adding an original clause (thus usually in the first 'solve' call).
+
+struct LratClause {
+  LratClause * next;            // link in list of garbage clauses
+  uint64_t id;                  // identifier of clause in proof
+  bool garbage;                 // deleted (still in watch lists)
+  bool reason;                  // root-level reason or conflict
+  unsigned size;
+  int literals[1];              // actually of length 'size'
+};
+
+struct LratWatch {
+  int blit;
+  LratClause * clause;
+  LratWatch () { }
+  LratWatch (int b, LratClause * c) : blit (b), clause (c) { }
+};
+
+typedef vector<LratWatch> LratWatcher;
+
+/*------------------------------------------------------------------------*/
+
+class LratBuilder {
+
+  Internal * internal;
+  Tracer * tracer;                      // receives the LRAT proof lines
+
+  // Capacity of variables, all the following are indexed by variable or
+  // (through 'l2u') by literal and resized together.
+  //
+  int64_t size_vars;
+
+  static unsigned l2u (int lit);
+  vector<signed char> vals;             // values of literals
+  vector<signed char> marks;            // mark bits of literals
+  vector<signed char> seen;             // variables in implication graph
+  vector<LratClause *> reasons;         // reasons of assigned variables
+  vector<LratWatcher> watchers;         // watchers of literals
+
+  signed char val (int lit);            // returns '-1', '0' or '1'
+  signed char & mark (int lit);
+  LratWatcher & watcher (int lit);
+
+  bool inconsistent;            // found or added empty clause
+
+  ClauseTable table;            // hash table of clause pointers
+  uint64_t num_garbage;         // number of garbage clauses
+  LratClause * garbage;         // linked list of garbage clauses
+
+  static LratClause * clause (uint64_t ref);
+
+  vector<int> simplified;       // sorted clause without duplicates
+  vector<int> unit_clause;      // derived unit or empty clause
+  vector<uint64_t> hints;       // antecedents of derived clause
+  vector<uint64_t> unit_hints;  // antecedents of derived root-level unit
+  vector<int> touched;          // variables marked in 'seen'
+
+  vector<int> trail;            // for propagation
+  unsigned root;                // root-level trail size
+  unsigned next_to_propagate;   // next to propagate on trail
+  unsigned materialized;        // root-level literals with unit reason
+
+  uint64_t last_id;             // last assigned (final) identifier
+
+  // Identifiers of lines derived while original clauses are added, which
+  // are not final yet, start at 'provisional'.  Until these lines are
+  // written they are encoded in 'deferred' (see 'defer').
+  //
+  static const uint64_t provisional = (uint64_t) 1 << 62;
+  bool deferring;
+  uint64_t num_provisional;
+  vector<uint64_t> deferred;
+
+  void enlarge_vars (int64_t idx);
+  void import_clause (const vector<int> &);
+
+  LratClause * insert (uint64_t id);    // insert clause in hash table
+  uint64_t find ();                     // slot of clause or 'table.size ()'
+
+  LratClause * new_clause (uint64_t id);
+  void delete_clause (LratClause *);
+  void watch_clause (LratClause *);
+  void collect_garbage_clauses ();
+
+  void assign (int lit, LratClause * reason);
+  LratClause * propagate ();            // returns conflict or zero
+  void backtrack (unsigned);
+  void propagate_root ();
+
+  uint64_t new_id ();
+  uint64_t final_id (uint64_t);
+  void add (uint64_t id, const vector<int> &, const vector<uint64_t> &);
+  void remove (uint64_t id);
+  void defer (uint64_t, const vector<int> *, const vector<uint64_t> *);
+  void flush_deferred ();
+
+  void materialize (unsigned upto);     // root-level units up to 'upto'
+  void add_empty_clause (LratClause * conflict);
+  void derive_empty_clause ();          // with hints in 'unit_hints'
+  bool derive ();                       // antecedents of 'simplified'
+  void add_clause (uint64_t id);
+
+  struct {
+
+    int64_t original;           // number of added original clauses
+    int64_t derived;            // number of added derived clauses
+    int64_t deleted;            // number of deleted clauses
+    int64_t units;              // number of derived root-level units
+    int64_t hints;              // number of antecedents
+    int64_t propagations;       // number of propagated literals
+    int64_t collections;        // garbage collections
+
+  } stats;
+
+public:
+
+  LratBuilder (Internal *, Tracer *);
+  ~LratBuilder ();
+
+  // Same as the 'Observer' interface.
+  //
+  void add_original_clause (const vector<int> &);
+  void add_derived_clause (const vector<int> &);
+  void delete_clause (const vector<int> &);
+
+  // Write all deferred lines (to be called before closing the proof).
+  //
+  void finish ();
+
+  void print_stats ();
+};
+
+}
+
+#endif
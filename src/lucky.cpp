@@ -270,8 +270,34 @@ int Internal::negative_horn_satisfiable () {
 
 /*------------------------------------------------------------------------*/
 
+// In incremental usage with many cheap 'solve' calls the lucky phases
+// would scan all clauses (up to eight times) on every call, even if only a
+// few clauses were added since the last call.  Thus we remember which of
+// the lucky strategies failed and only retry them after a certain fraction
+// of irredundant clauses were added or removed or new units were found.
+
+bool Internal::lucky_formula_changed () {
+  const int64_t added = stats.added.irredundant;
+  const int64_t removed = added - stats.current.irredundant;
+  const int64_t fixed = stats.all.fixed;
+  int64_t changes = added - last.lucky.added;
+  changes += removed - last.lucky.removed;
+  changes += fixed - last.lucky.fixed;
+  int64_t limit = opts.luckyretry;
+  limit *= stats.current.irredundant;
+  limit /= 1000;
+  const bool res = !opts.luckyretry || changes > limit;
+  if (res || !last.lucky.failed) {
+    last.lucky.added = added;
+    last.lucky.removed = removed;
+    last.lucky.fixed = fixed;
+  }
+  if (res) last.lucky.failed = 0;
+  LOG ("lucky formula changes %" PRId64 " limit %" PRId64, changes, limit);
+  return res;
+}
+
 int Internal::lucky_phases () {
-  assert (!level);
   require_mode (SEARCH);
   if (!opts.lucky) return 0;
 
@@ -280,19 +306,40 @@ int Internal::lucky_phases () {
   // Nothing done for constraint either.
   if (!assumptions.empty () || !constraint.empty ()) return 0;
 
+  assert (!level);
+
+  typedef int (Internal::*Strategy) ();
+  static const Strategy strategies[] = {
+    &Internal::trivially_false_satisfiable,
+    &Internal::trivially_true_satisfiable,
+    &Internal::forward_true_satisfiable,
+    &Internal::forward_false_satisfiable,
+    &Internal::backward_false_satisfiable,
+    &Internal::backward_true_satisfiable,
+    &Internal::positive_horn_satisfiable,
+    &Internal::negative_horn_satisfiable,
+  };
+  const unsigned size = sizeof strategies / sizeof *strategies;
+
+  if (!lucky_formula_changed () &&
+      last.lucky.failed == (1u << size) - 1) {
+    LOG ("all lucky strategies failed before on almost same formula");
+    stats.lucky.skipped += size;
+    return 0;
+  }
+
   START (search);
   START (lucky);
   assert (!searching_lucky_phases);
   searching_lucky_phases = true;
   stats.lucky.tried++;
-  int res       = trivially_false_satisfiable ();
-  if (!res) res = trivially_true_satisfiable ();
-  if (!res) res = forward_true_satisfiable ();
-  if (!res) res = forward_false_satisfiable ();
-  if (!res) res = backward_false_satisfiable ();
-  if (!res) res = backward_true_satisfiable ();
-  if (!res) res = positive_horn_satisfiable ();
-  if (!res) res = negative_horn_satisfiable ();
+  int res = 0;
+  for (unsigned i = 0; !res && i < size; i++) {
+    const unsigned bit = 1u << i;
+    if (last.lucky.failed & bit) { stats.lucky.skipped++; continue; }
+    res = (this->*strategies[i]) ();
+    if (!res) last.lucky.failed |= bit;
+  }
   if (res < 0) assert (termination_forced), res = 0;
   if (res == 10) stats.lucky.succeeded++;
   report ('l', !res);
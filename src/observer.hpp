@@ -13,7 +13,7 @@ public:
   virtual ~Observer () { }
 
   // An online proof 'Checker' needs to know original clauses too while a
-  // proof 'Tracer' will not implement this function.
+  // proof 'Tracer' only needs them for numbering clauses in LRAT format.
   //
   virtual void add_original_clause (const vector<int> &) { }
 
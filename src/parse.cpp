@@ -15,6 +15,15 @@ do { \
   return internal->error_message.append (__VA_ARGS__); \
 } while (0)
 
+// Parse error in binary files, where line numbers do not make sense.
+
+#define BER(...) \
+do { \
+  internal->error_message.init ("%s: byte %" PRIu64 ": parse error: ", \
+    file->name (), (uint64_t) file->bytes ()); \
+  return internal->error_message.append (__VA_ARGS__); \
+} while (0)
+
 /*------------------------------------------------------------------------*/
 
 // Parsing utilities.
@@ -76,6 +85,107 @@ Parser::parse_lit (int & ch, int & lit, int & vars, int strict) {
   return 0;
 }
 
+void Parser::flush_lits () {
+  if (lits.empty ()) return;
+  solver->add_clauses (lits.data (), lits.size ());
+  lits.clear ();
+}
+
+inline const char *
+Parser::parse_varint (uint64_t & res, const char * name) {
+  res = 0;
+  for (unsigned shift = 0;; shift += 7) {
+    const int ch = parse_char ();
+    if (ch == EOF) BER ("unexpected end-of-file in %s", name);
+    if (shift > 28) BER ("%s too large", name);
+    res |= (uint64_t) (ch & 0x7f) << shift;
+    if (!(ch & 0x80)) return 0;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Parsing CNF in binary format (after the first byte of the magic number
+// has been read).
+
+const char * Parser::parse_binary_non_profiled (int & vars, int strict) {
+
+#ifndef QUIET
+  double start = internal->time ();
+#endif
+
+  for (const char * p = binary_cnf_magic + 1; *p; p++)
+    if (parse_char () != *p) BER ("invalid binary CNF magic number");
+
+  uint64_t tmp;
+  const char * err = parse_varint (tmp, "<max-var>");
+  if (err) return err;
+  if (tmp > (uint64_t) INT_MAX) BER ("too large '<max-var>' in header");
+  vars = tmp;
+  err = parse_varint (tmp, "<num-clauses>");
+  if (err) return err;
+  const uint64_t clauses = tmp;
+
+  MSG ("found %sbinary CNF%s header with %d variables and %" PRIu64
+    " clauses", tout.green_code (), tout.normal_code (), vars, clauses);
+
+  if (strict != FORCED)
+    solver->reserve (vars);
+
+  if (parse_inccnf_too)
+    *parse_inccnf_too = false;
+
+  const uint64_t max_code = 2 * (uint64_t) INT_MAX + 1;
+  uint64_t parsed = 0;
+  int ch;
+
+  while ((ch = parse_char ()) != EOF) {
+
+    // The first byte of the clause size was already read to check for
+    // the end of the file.
+    //
+    uint64_t size = ch & 0x7f;
+    if (ch & 0x80) {
+      err = parse_varint (tmp, "clause size");
+      if (err) return err;
+      if (tmp > (uint64_t) INT_MAX >> 7) BER ("clause size too large");
+      size |= tmp << 7;
+    }
+
+    if (parsed++ >= clauses && strict != FORCED)
+      BER ("too many clauses");
+
+    uint64_t code = 0;
+    for (uint64_t i = 0; i < size; i++) {
+      err = parse_varint (tmp, "literal");
+      if (err) return err;
+      code += tmp;
+      if (code < 2 || code > max_code) BER ("invalid literal code");
+      const int idx = code / 2;
+      if (idx > vars) {
+        if (strict != FORCED)
+          BER ("literal %d exceeds maximum variable %d",
+            (code & 1) ? -idx : idx, vars);
+        else vars = idx;
+      }
+      add_lit ((code & 1) ? -idx : idx);
+    }
+    add_lit (0);
+  }
+  flush_lits ();
+
+  if (parsed < clauses && strict != FORCED)
+    BER ("clause missing");
+
+#ifndef QUIET
+  double end = internal->time ();
+  MSG ("parsed %" PRIu64 " clauses in %.2f seconds %s time",
+    parsed, end - start, internal->opts.realtime ? "real" : "process");
+#endif
+
+  return 0;
+}
+
 /*------------------------------------------------------------------------*/
 
 // Parsing CNF in DIMACS format.
@@ -90,10 +200,16 @@ const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
   int ch, clauses = 0;
   vars = 0;
 
+  // Binary CNF files start with a magic number which has a first byte
+  // different from any character which can start a DIMACS file.
+  //
+  ch = parse_char ();
+  if (ch == (unsigned char) binary_cnf_magic[0])
+    return parse_binary_non_profiled (vars, strict);
+
   // First read comments before header with possibly embedded options.
   //
-  for (;;) {
-    ch = parse_char ();
+  for (;; ch = parse_char ()) {
     if (strict != STRICT)
       if (ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r') continue;
     if (ch != 'c') break;
@@ -218,11 +334,12 @@ const char * Parser::parse_dimacs_non_profiled (int & vars, int strict) {
         if (ch == EOF)
           PER ("unexpected end-of-file in comment");
     }
-    solver->add (lit);
+    add_lit (lit);
     if (!found_inccnf_header &&
         !lit && parsed++ >= clauses && strict != FORCED)
       PER ("too many clauses");
   }
+  flush_lits ();
 
   if (lit) PER ("last clause without terminating '0'");
 
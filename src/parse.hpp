@@ -8,6 +8,22 @@ namespace CaDiCaL {
 
 // Factors out common functions for parsing of DIMACS and solution files.
 
+// Besides DIMACS we also parse (and 'write_dimacs' optionally writes) the
+// following compact binary CNF format, which is recognized by its magic
+// number in the first four bytes ('\177CNF' can not start a DIMACS file).
+//
+//   <magic> <vars> <clauses> <clause> ... <clause>
+//
+// The number of variables '<vars>' and clauses '<clauses>' and everything
+// in '<clause>' are encoded as unsigned variable length integers with
+// seven bits per byte, least significant group first and the high bit set
+// in all but the last byte (as in binary DRAT proofs).  A '<clause>' is
+// its size followed by its literals sorted by their code '2*idx + sign'.
+// The first code is stored as is and then only the (non-negative)
+// difference to the previous code, which mostly fits into one byte.
+
+static const char * const binary_cnf_magic = "\177CNF";
+
 class File;
 struct External;
 struct Internal;
@@ -32,12 +48,24 @@ class Parser {
   const char * parse_string (const char * str, char prev);
   const char * parse_positive_int (int & ch, int & res, const char * name);
   const char * parse_lit (int & ch, int & lit, int & vars, int strict);
+  const char * parse_varint (uint64_t & res, const char * name);
+  const char * parse_binary_non_profiled (int & vars, int strict);
   const char * parse_dimacs_non_profiled (int & vars, int strict);
   const char * parse_solution_non_profiled ();
 
   bool * parse_inccnf_too;
   vector<int> * cubes;
 
+  // Parsed literals are added to the solver in bulk through 'add_clauses'
+  // which is faster than calling 'add' for each literal.
+
+  vector<int> lits;
+  void add_lit (int lit) {
+    lits.push_back (lit);
+    if (lits.size () >= (1u << 16)) flush_lits ();
+  }
+  void flush_lits ();
+
 public:
 
   // Parse a DIMACS CNF or ICNF file.
@@ -58,6 +86,7 @@ public:
   // form of parsing is enforced  for the value '2' of 'strict', in which
   // case the header can not have additional white space, while a value of
   // '1' exactly relaxes this, e.g., 'p cnf \t  1   3  \r\n' becomes legal.
+  // Files in the binary CNF format described above are parsed too.
   //
   const char * parse_dimacs (int & vars, int strict);
 
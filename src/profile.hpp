@@ -57,6 +57,7 @@ PROFILE(extend,3) \
 PROFILE(instantiate,2) \
 PROFILE(lucky,2) \
 PROFILE(lookahead,2) \
+PROFILE(lrat,2) \
 PROFILE(minimize,4) \
 PROFILE(shrink, 4) \
 PROFILE(parse,0) /*Set to '0' as 'opts.profile' might change in parsing*/ \
@@ -20,7 +20,7 @@ void Internal::new_proof_on_demand () {
 void Internal::trace (File * file) {
   assert (!tracer);
   new_proof_on_demand ();
-  tracer = new Tracer (this, file, opts.binary);
+  tracer = new Tracer (this, file, opts.binary, opts.lrat);
   LOG ("PROOF connecting proof tracer");
   proof->connect (tracer);
 }
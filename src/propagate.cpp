@@ -140,6 +140,38 @@ void Internal::search_assign_driving (int lit, Clause * c) {
 // propagation costs (2013 JAIR article by Ian Gent) at the expense of four
 // more bytes for each clause.
 
+// Similar to 'probe_propagate' we prioritize binary clauses and propagate
+// them to completion first using the separate trail pointer 'propagated2'
+// before visiting any long clause.  This way binary implications (and
+// binary conflicts) are found as early as possible and long clauses are
+// only visited with all binary consequences already assigned, which makes
+// it more likely that their blocking literal or other watch is satisfied.
+
+// The binary propagation below only scans the prefix of binary watches of
+// a watch list.  Binary watches are connected before long watches in
+// 'connect_watches' and then kept in front by 'sort_watches', but binary
+// clauses learned in between are simply appended.  Those are still
+// propagated correctly in the long clause loop of 'propagate', which thus
+// also has to handle binary watches, but only later.
+
+inline void Internal::propagate2 () {
+
+  while (!conflict && propagated2 != trail.size ()) {
+
+    const int lit = -trail[propagated2++];
+    LOG ("propagating %d over binary clauses", -lit);
+    const Watches & ws = watches (lit);
+
+    for (const auto & w : ws) {
+      if (!w.binary ()) break;             // end of binary prefix
+      const signed char b = val (w.blit);
+      if (b > 0) continue;
+      if (b < 0) conflict = w.clause ();    // but continue ...
+      else search_assign (w.blit, w.clause ());
+    }
+  }
+}
+
 bool Internal::propagate () {
 
   if (level) require_mode (SEARCH);
@@ -152,18 +184,43 @@ bool Internal::propagate () {
   //
   int64_t before = propagated;
 
-  while (!conflict && propagated != trail.size ()) {
+  // Optionally we look ahead 'prefetch' watches in the long clause loop
+  // and prefetch the value of their blocking literal and the header of
+  // their clause.  This hides memory latency on large instances where the
+  // clauses do not fit into the cache any more.  Disabled by default.
+  //
+  const int prefetch = opts.prefetch;
+
+  propagated2 = propagated;
+
+  while (!conflict) {
+
+    if (propagated2 != trail.size ()) {
+      propagate2 ();
+      continue;
+    }
+
+    if (propagated == trail.size ()) break;
 
     const int lit = -trail[propagated++];
-    LOG ("propagating %d", -lit);
+    LOG ("propagating %d over large clauses", -lit);
     Watches & ws = watches (lit);
 
+    // Skip the prefix of binary watches already handled in 'propagate2'.
+
     const const_watch_iterator eow = ws.end ();
     watch_iterator j = ws.begin ();
+    while (j != eow && j->binary ()) j++;
     const_watch_iterator i = j;
 
     while (i != eow) {
 
+      if (prefetch && eow - i > prefetch) {
+        const Watch & p = i[prefetch];
+        __builtin_prefetch (vals + p.blit, 0, 1);
+        if (!p.binary ()) __builtin_prefetch (p.clause (), 1, 1);
+      }
+
       const Watch w = *j++ = *i++;
       const signed char b = val (w.blit);
 
@@ -174,7 +231,7 @@ bool Internal::propagate () {
         // In principle we can ignore garbage binary clauses too, but that
         // would require to dereference the clause pointer all the time with
         //
-        // if (w.clause->garbage) { j--; continue; } // (*)
+        // if (w.clause ()->garbage) { j--; continue; } // (*)
         //
         // This is too costly.  It is however necessary to produce correct
         // proof traces if binary clauses are traced to be deleted ('d ...'
@@ -196,8 +253,8 @@ bool Internal::propagate () {
         // to access the clause at all (only during conflict analysis, and
         // there also only to simplify the code).
 
-        if (b < 0) conflict = w.clause;          // but continue ...
-        else search_assign (w.blit, w.clause);
+        if (b < 0) conflict = w.clause ();       // but continue ...
+        else search_assign (w.blit, w.clause ());
 
       } else {
 
@@ -208,9 +265,11 @@ bool Internal::propagate () {
         // the solver.  Note, that this check is positive very rarely and
         // thus branch prediction should be almost perfect here.
 
-        if (w.clause->garbage) { j--; continue; }
+        Clause * c = w.clause ();
+
+        if (c->garbage) { j--; continue; }
 
-        literal_iterator lits = w.clause->begin ();
+        literal_iterator lits = c->begin ();
 
         // Simplify code by forcing 'lit' to be the second literal in the
         // clause.  This goes back to MiniSAT.  We use a branch-less version
@@ -235,8 +294,8 @@ bool Internal::propagate () {
           // one failed to find a replacement another one starting at the
           // first non-watched literal until the saved position.
 
-          const int size = w.clause->size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const int size = c->size;
+          const literal_iterator middle = lits + c->pos;
           const const_literal_iterator end = lits + size;
           literal_iterator k = middle;
 
@@ -251,14 +310,14 @@ bool Internal::propagate () {
           if (v < 0) {  // need second search starting at the head?
 
             k = lits + 2;
-            assert (w.clause->pos <= size);
+            assert (c->pos <= size);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
 
-          w.clause->pos = k - lits;  // always save position
+          c->pos = k - lits;  // always save position
 
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          assert (lits + 2 <= k), assert (k <= c->end ());
 
           if (v > 0) {
 
@@ -270,13 +329,13 @@ bool Internal::propagate () {
 
             // Found new unassigned replacement literal to be watched.
 
-            LOG (w.clause, "unwatch %d in", lit);
+            LOG (c, "unwatch %d in", lit);
 
             lits[0] = other;
             lits[1] = r;
             *k = lit;
 
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
 
             j--;  // Drop this watch from the watch list of 'lit'.
 
@@ -287,7 +346,7 @@ bool Internal::propagate () {
             // The other watch is unassigned ('!u') and all other literals
             // assigned to false (still 'v < 0'), thus we found a unit.
             //
-            search_assign (other, w.clause);
+            search_assign (other, c);
 
             // Similar code is in the implementation of the SAT'18 paper on
             // chronological backtracking but in our experience, this code
@@ -316,11 +375,11 @@ bool Internal::propagate () {
                 assert (s);
                 assert (pos < size);
 
-                LOG (w.clause, "unwatch %d in", lit);
+                LOG (c, "unwatch %d in", lit);
                 lits[pos] = lit;
                 lits[0] = other;
                 lits[1] = s;
-                watch_literal (s, other, w.clause);
+                watch_literal (s, other, c);
 
                 j--;  // Drop this watch from the watch list of 'lit'.
               }
@@ -333,7 +392,7 @@ bool Internal::propagate () {
             // The other watch is assigned false ('u < 0') and all other
             // literals as well (still 'v < 0'), thus we found a conflict.
 
-            conflict = w.clause;
+            conflict = c;
             break;
           }
         }
@@ -62,12 +62,7 @@ void External::restore_clause (
 
 /*------------------------------------------------------------------------*/
 
-void External::restore_clauses () {
-
-  assert (internal->opts.restoreall == 2 || !tainted.empty ());
-
-  START (restore);
-  internal->stats.restorations++;
+void External::restore_clauses_by_scanning () {
 
   struct { int64_t weakened, satisfied, restored, removed; } clauses;
   memset (&clauses, 0, sizeof clauses);
@@ -101,13 +96,15 @@ void External::restore_clauses () {
     // Copy witness part and try to find a tainted witness literal in it.
     //
     int tlit = 0;                               // Negation tainted.
+    bool removed_by_index = false;
     int elit;
     //
     assert (p != end_of_extension);
     //
     while ((elit = *q++ = *p++)) {
 
-      if (marked (tainted, -elit)) {
+      if (elit == INT_MIN) removed_by_index = true;
+      else if (marked (tainted, -elit)) {
         tlit = elit;
         LOG ("negation of witness literal %d tainted", tlit);
       }
@@ -135,7 +132,13 @@ void External::restore_clauses () {
       satisfied = 0;
     }
 
-    if (satisfied || tlit || internal->opts.restoreall) {
+    if (removed_by_index) {
+
+      LOG (p, end_of_clause, "dropping clause restored before");
+      p = end_of_clause;
+      q = saved;
+
+    } else if (satisfied || tlit || internal->opts.restoreall) {
 
       if (satisfied) {
         LOG (p, end_of_clause,
@@ -163,6 +166,11 @@ void External::restore_clauses () {
   extension.resize (q - extension.begin ());
   shrink_vector (extension);
 
+  internal->stats.restorevisits += clauses.weakened;
+
+  witnessed.clear ();
+  indexed = removed = 0;
+
 #ifndef QUIET
   if (clauses.satisfied)
     PHASE ("restore", internal->stats.restorations,
@@ -213,6 +221,154 @@ void External::restore_clauses () {
       assert (p != begin_of_extension);
     }
   }
+}
+
+/*------------------------------------------------------------------------*/
+
+// Extend the witness index to the current extension stack.  Since clauses
+// are only pushed on the extension stack this only has to index clauses
+// pushed since the last restore and is thus linear in the number of
+// weakened clauses and not in the size of the extension stack.
+
+void External::index_extension () {
+  const size_t size = extension.size ();
+  if (indexed == size) return;
+  if (witnessed.size () < 2u*max_var)
+    witnessed.resize (2u*max_var);
+  size_t i = indexed;
+  while (i != size) {
+    assert (!extension[i]);
+    const size_t start = i++;
+    int elit;
+    while ((elit = extension[i++])) {
+      assert (elit != INT_MIN);
+      witnessed[elit2ulit (elit)].push_back (start);
+    }
+    while (i != size && extension[i])
+      i++;
+  }
+  LOG ("indexed %zd extension stack entries", size - indexed);
+  indexed = size;
+}
+
+// Restoring through the witness index only visits clauses which have the
+// negation of a tainted literal as witness.  These clauses are restored in
+// the order in which they occur on the extension stack, i.e., the same as
+// in 'restore_clauses_by_scanning', and literals tainted by restoring a
+// clause only lead to restoring clauses above it.  Restored clauses are
+// removed lazily (by overwriting their witness with 'INT_MIN') and
+// physically removed if they make up half of the extension stack.
+
+void External::restore_clauses_by_index () {
+
+  index_extension ();
+
+  int64_t visited = 0, restored = 0;
+
+  priority_queue<size_t, vector<size_t>, greater<size_t>> schedule;
+  vector<bool> scheduled;
+
+  // Schedule clauses starting at or above 'start' with the negation of
+  // the tainted literal 'elit' as witness.
+  //
+  const auto schedule_clauses = [&] (int elit, size_t start) {
+    mark (scheduled, elit);
+    const unsigned ulit = elit2ulit (-elit);
+    if (ulit >= witnessed.size ()) return;
+    for (const auto & pos : witnessed[ulit])
+      if (pos >= start)
+        schedule.push (pos);
+  };
+
+  unsigned numtainted = 0;
+  for (unsigned ulit = 0; ulit < tainted.size (); ulit++) {
+    if (!tainted[ulit]) continue;
+    const int eidx = 1 + (ulit >> 1);
+    const int elit = (ulit & 1) ? -eidx : eidx;
+    schedule_clauses (elit, 0);
+    numtainted++;
+  }
+
+  PHASE ("restore", internal->stats.restorations,
+    "starting with %u tainted literals %.0f%% and %zd scheduled clauses",
+    numtainted, percent (numtainted, 2u*max_var), schedule.size ());
+
+  vector<int> unwitnessed;
+  size_t last = extension.size ();             // No clause starts here.
+
+  while (!schedule.empty ()) {
+
+    const size_t pos = schedule.top ();
+    schedule.pop ();
+    if (pos == last) continue;
+    last = pos;
+
+    const auto begin_of_witness = extension.begin () + pos + 1;
+    if (*begin_of_witness == INT_MIN) continue;
+    visited++;
+
+    auto end_of_witness = begin_of_witness;
+    while (*end_of_witness) end_of_witness++;
+
+    const auto begin_of_clause = end_of_witness + 1;
+    auto end_of_clause = begin_of_clause;
+    while (end_of_clause != extension.end () && *end_of_clause)
+      end_of_clause++;
+
+    restore_clause (begin_of_clause, end_of_clause);
+    restored++;
+
+    for (auto p = begin_of_witness; p != end_of_witness; p++) {
+      unwitnessed.push_back (*p);
+      *p = INT_MIN;
+    }
+    removed += end_of_clause - extension.begin () - pos;
+
+    for (auto p = begin_of_clause; p != end_of_clause; p++) {
+      const int elit = *p;
+      if (marked (tainted, elit) && !marked (scheduled, elit))
+        schedule_clauses (elit, pos + 1);
+    }
+  }
+
+  internal->stats.restorevisits += visited;
+
+  PHASE ("restore", internal->stats.restorations,
+    "restored %" PRId64 " clauses visiting %" PRId64
+    " out of %" PRId64 " weakened clauses",
+    restored, visited, internal->stats.weakened);
+
+  LOG ("extension stack clean");
+  tainted.clear ();
+
+  // Unmark witness bits of literals which are not witness of a remaining
+  // clause anymore.
+  //
+  for (const auto & elit : unwitnessed) {
+    if (!marked (witness, elit)) continue;
+    bool still_witness = false;
+    for (const auto & pos : witnessed[elit2ulit (elit)])
+      if (extension[pos + 1] != INT_MIN) { still_witness = true; break; }
+    if (!still_witness) unmark (witness, elit);
+  }
+}
+
+/*------------------------------------------------------------------------*/
+
+void External::restore_clauses () {
+
+  assert (internal->opts.restoreall == 2 || !tainted.empty ());
+
+  START (restore);
+  internal->stats.restorations++;
+
+  if (internal->opts.restoreall ||
+      internal->opts.restoreflush ||
+      !internal->opts.restoreindex ||
+      2*removed > extension.size ())
+    restore_clauses_by_scanning ();
+  else
+    restore_clauses_by_index ();
 
   STOP (restore);
 }
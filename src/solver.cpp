@@ -536,6 +536,48 @@ void Solver::add (int lit) {
   LOG_API_CALL_END ("add", lit);
 }
 
+void Solver::add_clauses (const int * lits, size_t size) {
+#ifndef NTRACING
+  if (trace_api_file) {
+    // Keep API traces in terms of 'add' calls (which 'mobical' replays).
+    for (size_t i = 0; i < size; i++) add (lits[i]);
+    return;
+  }
+#endif
+  LOG_API_CALL_BEGIN ("add_clauses");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (lits || !size, "zero literal buffer");
+  if (size) {
+    int max_idx = 0;
+    for (const int * p = lits, * end = lits + size; p != end; p++) {
+      const int lit = *p;
+      if (!lit) continue;
+      REQUIRE_VALID_LIT (lit);
+      const int idx = abs (lit);
+      if (idx > max_idx) max_idx = idx;
+    }
+    transition_to_unknown_state ();
+    external->add_clauses (lits, size, max_idx);
+    adding_clause = lits[size - 1];
+    if (adding_clause) STATE (ADDING);
+    else if (!adding_constraint) STATE (UNKNOWN);
+  }
+  LOG_API_CALL_END ("add_clauses");
+}
+
+void Solver::add_clause (const int * lits, size_t size) {
+  REQUIRE_VALID_STATE ();
+  REQUIRE (lits || !size, "zero literal buffer");
+  for (const int * p = lits, * end = lits + size; p != end; p++)
+    REQUIRE (*p, "zero literal in clause");
+  add_clauses (lits, size);
+  add (0);
+}
+
+void Solver::add_clause (const vector<int> & clause) {
+  add_clause (clause.data (), clause.size ());
+}
+
 void Solver::constrain (int lit) {
   TRACE ("constrain", lit);
   REQUIRE_VALID_STATE ();
@@ -577,6 +619,14 @@ Solver::CubesWithStatus Solver::generate_cubes (int depth, int min_depth) {
   return cubes2;
 }
 
+int Solver::generate_cubes (int depth, CubeSink & sink, int min_depth) {
+  TRACE ("lookahead_cubes");
+  REQUIRE_VALID_OR_SOLVING_STATE ();
+  int res = external->generate_cubes (depth, min_depth, sink);
+  TRACE ("lookahead_cubes");
+  return res;
+}
+
 void Solver::reset_assumptions () {
   TRACE ("reset_assumptions");
   REQUIRE_VALID_STATE ();
@@ -634,6 +684,64 @@ int Solver::solve () {
   return res;
 }
 
+// The queries of a batch are sorted such that queries with the same
+// assumption prefix follow each other and the common prefix can be kept on
+// the trail (see 'Internal::reuse_assumptions').  In order to increase the
+// length of common prefixes, the literals of each query are first sorted
+// by the number of queries they occur in (more frequent first).  Then the
+// lexicographic order of the queries amounts to a depth-first traversal of
+// the trie of all queries.
+
+size_t Solver::solve_batch (const vector<vector<int>> & queries,
+                            ResultSink & sink) {
+  LOG_API_CALL_BEGIN ("solve_batch");
+  REQUIRE_READY_STATE ();
+
+  int max_lit = 0;
+  for (const auto & query : queries)
+    for (const auto & lit : query) {
+      REQUIRE_VALID_LIT (lit);
+      max_lit = max (max_lit, abs (lit));
+    }
+
+  vector<size_t> count (2*(size_t) max_lit + 2, 0);
+  auto idx = [] (int lit) { return 2*(size_t) abs (lit) + (lit < 0); };
+  for (const auto & query : queries)
+    for (const auto & lit : query)
+      count[idx (lit)]++;
+
+  vector<vector<int>> sorted (queries);
+  for (auto & query : sorted)
+    sort (query.begin (), query.end (), [&] (int a, int b) {
+      const size_t c = count[idx (a)], d = count[idx (b)];
+      return c > d || (c == d && a < b);
+    });
+
+  vector<size_t> order (queries.size ());
+  for (size_t i = 0; i < order.size (); i++) order[i] = i;
+  stable_sort (order.begin (), order.end (), [&] (size_t i, size_t j) {
+    return sorted[i] < sorted[j];
+  });
+
+  vector<int> failed_lits;
+  size_t res = 0;
+  for (const auto i : order) {
+    for (const auto & lit : sorted[i])
+      assume (lit);
+    const int status = solve ();
+    failed_lits.clear ();
+    if (status == 20)
+      for (const auto & lit : sorted[i])
+        if (failed (lit))
+          failed_lits.push_back (lit);
+    res++;
+    if (!sink.result (i, status, failed_lits)) break;
+    if (!status) break;
+  }
+  LOG_API_CALL_RETURNS ("solve_batch", (int) res);
+  return res;
+}
+
 int Solver::simplify (int rounds) {
   TRACE ("simplify", rounds);
   REQUIRE_READY_STATE ();
@@ -772,6 +880,35 @@ void Solver::disconnect_learner () {
 
 /*===== IPASIR END =======================================================*/
 
+void Solver::connect_clause_source (ClauseSource * source) {
+  LOG_API_CALL_BEGIN ("connect_clause_source");
+  REQUIRE_VALID_STATE ();
+  REQUIRE (source, "can not connect zero clause source");
+#ifdef LOGGING
+  if (external->source)
+    LOG ("connecting new clause source (disconnecting previous one)");
+  else
+    LOG ("connecting new clause source (no previous one)");
+#endif
+  external->source = source;
+  LOG_API_CALL_END ("connect_clause_source");
+}
+
+void Solver::disconnect_clause_source () {
+  LOG_API_CALL_BEGIN ("disconnect_clause_source");
+  REQUIRE_VALID_STATE ();
+#ifdef LOGGING
+    if (external->source)
+      LOG ("disconnecting previous clause source");
+    else
+      LOG ("ignoring to disconnect clause source (no previous one)");
+#endif
+  external->source = 0;
+  LOG_API_CALL_END ("disconnect_clause_source");
+}
+
+/*------------------------------------------------------------------------*/
+
 int Solver::active () const {
   TRACE ("active");
   REQUIRE_VALID_STATE ();
@@ -1122,7 +1259,45 @@ public:
   }
 };
 
-const char * Solver::write_dimacs (const char * path, int min_max_var) {
+// Writes clauses in the binary CNF format described in 'parse.hpp'.
+
+class BinaryClauseWriter : public ClauseIterator {
+  File * file;
+  vector<unsigned> codes;
+  bool put (unsigned x) {
+    unsigned char ch;
+    while (x & ~0x7f) {
+      ch = (x & 0x7f) | 0x80;
+      if (!file->put (ch)) return false;
+      x >>= 7;
+    }
+    ch = x;
+    return file->put (ch);
+  }
+public:
+  BinaryClauseWriter (File * f) : file (f) { }
+  bool header (int vars, unsigned clauses) {
+    if (!file->put (binary_cnf_magic)) return false;
+    if (!put (vars)) return false;
+    return put (clauses);
+  }
+  bool clause (const vector<int> & c) {
+    codes.clear ();
+    for (const auto & lit : c)
+      codes.push_back (2u*abs (lit) + (lit < 0));
+    sort (codes.begin (), codes.end ());
+    if (!put (codes.size ())) return false;
+    unsigned prev = 0;
+    for (const auto & code : codes) {
+      if (!put (code - prev)) return false;
+      prev = code;
+    }
+    return true;
+  }
+};
+
+const char * Solver::write_dimacs (const char * path, int min_max_var,
+                                   bool binary) {
   LOG_API_CALL_BEGIN ("write_dimacs", path, min_max_var);
   REQUIRE_VALID_STATE ();
 #ifndef QUIET
@@ -1133,9 +1308,30 @@ const char * Solver::write_dimacs (const char * path, int min_max_var) {
   (void) traverse_clauses (counter);
   LOG ("found maximal variable %d and %" PRId64 " clauses",
     counter.vars, counter.clauses);
-  File * file = File::write (internal, path);
+  // The header of binary CNF files has an 'unsigned' clause count and
+  // files with more clauses could not be read back (in strict mode).
+  //
+  File * file = 0;
   const char * res = 0;
-  if (file) {
+  if (binary && counter.clauses > UINT_MAX)
+    res = internal->error_message.init (
+            "too many clauses (%" PRId64 ") for binary CNF file '%s'",
+            counter.clauses, path);
+  else if (!(file = File::write (internal, path)))
+    res = internal->error_message.init (
+            "failed to open DIMACS file '%s' for writing", path);
+  else if (binary) {
+    int actual_max_vars = max (min_max_var, counter.vars);
+    MSG ("writing %sbinary CNF%s header with %d variables "
+      "and %" PRId64 " clauses", tout.green_code (), tout.normal_code (),
+      actual_max_vars, counter.clauses);
+    BinaryClauseWriter writer (file);
+    if (!writer.header (actual_max_vars, (unsigned) counter.clauses) ||
+        !traverse_clauses (writer))
+      res = internal->error_message.init (
+              "writing to binary CNF file '%s' failed", path);
+    delete file;
+  } else {
     int actual_max_vars = max (min_max_var, counter.vars);
     MSG ("writing %s'p cnf %d %" PRId64 "'%s header",
       tout.green_code (), actual_max_vars, counter.clauses,
@@ -1150,8 +1346,7 @@ const char * Solver::write_dimacs (const char * path, int min_max_var) {
       res = internal->error_message.init (
               "writing to DIMACS file '%s' failed", path);
     delete file;
-  } else res = internal->error_message.init (
-                 "failed to open DIMACS file '%s' for writing", path);
+  }
 #ifndef QUIET
   if (!res) {
     const double end = internal->time ();
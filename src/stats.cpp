@@ -55,6 +55,10 @@ void Stats::print (Internal * internal) {
 
   SECTION ("statistics");
 
+  if (all || stats.assumptions.reused) {
+  PRT ("assumptions:     %15" PRId64 "   %10.2f %%  reused", stats.assumptions.solves, percent (stats.assumptions.reused, stats.assumptions.solves));
+  PRT ("  reusedlevels:  %15" PRId64 "   %10.2f    per reuse", stats.assumptions.levels, relative (stats.assumptions.levels, stats.assumptions.reused));
+  }
   if (all || stats.blocked) {
   PRT ("blocked:         %15" PRId64 "   %10.2f %%  of irredundant clauses", stats.blocked, percent (stats.blocked, stats.added.irredundant));
   PRT ("  blockings:     %15" PRId64 "   %10.2f    internal", stats.blockings, relative (stats.conflicts, stats.blockings));
@@ -89,6 +93,9 @@ void Stats::print (Internal * internal) {
   PRT ("  asymmetric:    %15" PRId64 "   %10.2f %%  of covered clauses", stats.cover.asymmetric, percent (stats.cover.asymmetric, stats.cover.total));
   PRT ("  blocked:       %15" PRId64 "   %10.2f %%  of covered clauses", stats.cover.blocked, percent (stats.cover.blocked, stats.cover.total));
   }
+  if (all || stats.cubes) {
+  PRT ("cubes:           %15" PRId64 "   %10.2f %%  cut off", stats.cubes, percent (stats.cutoffcubes, stats.cubes));
+  }
   if (all || stats.decisions) {
   PRT ("decisions:       %15" PRId64 "   %10.2f    per second", stats.decisions, relative (stats.decisions, t));
   PRT ("  searched:      %15" PRId64 "   %10.2f    per decision", stats.searched, relative (stats.searched, stats.decisions));
@@ -132,6 +139,11 @@ void Stats::print (Internal * internal) {
   PRT ("instantiated:    %15" PRId64 "   %10.2f %%  of tried", stats.instantiated, percent (stats.instantiated, stats.instried));
   PRT ("  instrounds:    %15" PRId64 "   %10.2f %%  of elimrounds", stats.instrounds, percent (stats.instrounds, stats.elimrounds));
   }
+  if (all || stats.imported.clauses || stats.imported.units) {
+  PRT ("imported:        %15" PRId64 "   %10.2f    per conflict", stats.imported.clauses, relative (stats.imported.clauses, stats.conflicts));
+  PRT ("  importunits:   %15" PRId64 "   %10.2f %%  of all variables", stats.imported.units, percent (stats.imported.units, stats.vars));
+  PRT ("  importskipped: %15" PRId64 "   %10.2f %%  per imported", stats.imported.skipped, percent (stats.imported.skipped, stats.imported.clauses + stats.imported.units));
+  }
   if (all || stats.conflicts) {
   PRT ("learned:         %15" PRId64 "   %10.2f %%  per conflict", stats.learned.clauses, percent (stats.learned.clauses, stats.conflicts));
   PRT ("  bumped:        %15" PRId64 "   %10.2f    per learned", stats.bumped, relative (stats.bumped, stats.learned.clauses));
@@ -140,6 +152,11 @@ void Stats::print (Internal * internal) {
   PRT ("  promoted2:     %15" PRId64 "   %10.2f %%  per learned", stats.promoted2, percent (stats.promoted2, stats.learned.clauses));
   PRT ("  improvedglue:  %15" PRId64 "   %10.2f %%  per learned", stats.improvedglue, percent (stats.improvedglue, stats.learned.clauses));
   }
+  if (all || stats.lookaheads) {
+  PRT ("lookaheads:      %15" PRId64 "   %10.2f    per cube", stats.lookaheads, relative (stats.lookaheads, stats.cubes));
+  PRT ("  lookcached:    %15" PRId64 "   %10.2f %%  per lookahead", stats.lookaheadcached, percent (stats.lookaheadcached, stats.lookaheads));
+  PRT ("  looksnapshots: %15" PRId64 "   %10.2f %%  per lookahead", stats.lookaheadsnapshots, percent (stats.lookaheadsnapshots, stats.lookaheads));
+  }
   if (all || stats.lucky.succeeded) {
   PRT ("lucky:           %15" PRId64 "   %10.2f %%  of tried", stats.lucky.succeeded, percent (stats.lucky.succeeded, stats.lucky.tried));
   PRT ("  constantzero   %15" PRId64 "   %10.2f %%  of tried", stats.lucky.constant.zero, percent (stats.lucky.constant.zero, stats.lucky.tried));
@@ -150,6 +167,7 @@ void Stats::print (Internal * internal) {
   PRT ("  forwardzero    %15" PRId64 "   %10.2f %%  of tried", stats.lucky.forward.zero, percent (stats.lucky.forward.zero, stats.lucky.tried));
   PRT ("  positivehorn   %15" PRId64 "   %10.2f %%  of tried", stats.lucky.horn.positive, percent (stats.lucky.horn.positive, stats.lucky.tried));
   PRT ("  negativehorn   %15" PRId64 "   %10.2f %%  of tried", stats.lucky.horn.negative, percent (stats.lucky.horn.negative, stats.lucky.tried));
+  PRT ("  skipped        %15" PRId64 "   %10.2f    per tried", stats.lucky.skipped, relative (stats.lucky.skipped, stats.lucky.tried));
   }
   PRT ("  extendbytes:   %15zd   %10.2f    bytes and MB", extendbytes, extendbytes/(double)(1l<<20));
   if (all || stats.learned.clauses)
@@ -193,6 +211,7 @@ void Stats::print (Internal * internal) {
   PRT ("restored:        %15" PRId64 "   %10.2f %%  per weakened", stats.restored, percent (stats.restored, stats.weakened));
   PRT ("  restorations:  %15" PRId64 "   %10.2f %%  per extension", stats.restorations, percent (stats.restorations, stats.extensions));
   PRT ("  literals:      %15" PRId64 "   %10.2f    per restored clause", stats.restoredlits, relative (stats.restoredlits, stats.restored));
+  PRT ("  visited:       %15" PRId64 "   %10.2f    per restoration", stats.restorevisits, relative (stats.restorevisits, stats.restorations));
   }
   if (all || stats.stabphases) {
   PRT ("stabilizing:     %15" PRId64 "   %10.2f %%  of conflicts", stats.stabphases, percent (stats.stabconflicts, stats.conflicts));
@@ -304,4 +323,19 @@ void Checker::print_stats () {
   MSG ("units:           %15" PRId64 "", stats.units);
 }
 
+void LratBuilder::print_stats () {
+
+  if (!stats.original && !stats.derived) return;
+
+  SECTION ("LRAT statistics");
+
+  MSG ("original:        %15" PRId64 "", stats.original);
+  MSG ("derived:         %15" PRId64 "", stats.derived);
+  MSG ("deleted:         %15" PRId64 "   %10.2f %%  of all clauses", stats.deleted, percent (stats.deleted, stats.original + stats.derived + stats.units));
+  MSG ("units:           %15" PRId64 "   %10.2f %%  of derived", stats.units, percent (stats.units, stats.derived));
+  MSG ("hints:           %15" PRId64 "   %10.2f    per derived", stats.hints, relative (stats.hints, stats.derived + stats.units));
+  MSG ("propagations:    %15" PRId64 "   %10.2f    per derived", stats.propagations, relative (stats.propagations, stats.derived));
+  MSG ("collections:     %15" PRId64 "", stats.collections);
+}
+
 }
@@ -26,6 +26,12 @@ struct Stats {
     int64_t walk;       // propagated during local search
   } propagations;
 
+  struct {
+    int64_t solves;     // solve calls with assumptions on the trail
+    int64_t reused;     // solve calls reusing assumption levels
+    int64_t levels;     // reused assumption levels
+  } assumptions;
+
   int64_t condassinit;  // initial assigned literals
   int64_t condassirem;  // initial assigned literals for blocked
   int64_t condassrem;   // remaining assigned literals for blocked
@@ -52,6 +58,12 @@ struct Stats {
     int64_t irredundant;
   } current, added;  // Clauses.
 
+  struct {
+    int64_t clauses;    // imported non-unit clauses
+    int64_t units;      // imported unit clauses
+    int64_t skipped;    // skipped imported clauses
+  } imported;
+
   struct { double process, real; } time;
 
   struct {
@@ -64,6 +76,7 @@ struct Stats {
   struct {
     int64_t tried;
     int64_t succeeded;
+    int64_t skipped;    // failed strategies not retried
     struct { int64_t one, zero; } constant, forward, backward;
     struct { int64_t positive, negative; } horn;
   } lucky;
@@ -187,6 +200,11 @@ struct Stats {
   int64_t probingrounds;// number of probing rounds
   int64_t probesuccess; // number successful probing phases
   int64_t probed;       // number of probed literals
+  int64_t cubes;        // number of generated cubes
+  int64_t cutoffcubes;  // cubes cut off by 'lookaheadfree'
+  int64_t lookaheads;   // lookahead probing calls
+  int64_t lookaheadcached; // lookaheads with cached scores
+  int64_t lookaheadsnapshots; // clauses copied for parallel lookahead
   int64_t failed;       // number of failed literals
   int64_t hyperunary;   // hyper unary resolved unit clauses
   int64_t probefailed;  // failed literals from probing
@@ -205,6 +223,7 @@ struct Stats {
   int64_t restored;     // number of restored clauses
   int64_t reactivated;  // number of reactivated clauses
   int64_t restoredlits; // number of restored literals
+  int64_t restorevisits;// visited extension stack clauses in restore
 
   int64_t preprocessings;
 
@@ -393,7 +393,7 @@ bool Internal::subsume_round () {
       continue;
     }
 
-    if (c->subsume) left_over_from_last_subsumption_round++;
+    if (cold (c).subsume) left_over_from_last_subsumption_round++;
     schedule.push_back (ClauseSize (c->size, c));
     for (const auto & lit : *c)
       noccs (lit)++;
@@ -407,7 +407,7 @@ bool Internal::subsume_round () {
   if (!left_over_from_last_subsumption_round)
     for (auto cs : schedule)
       if (cs.clause->size > 2)
-        cs.clause->subsume = true;
+        cold (cs.clause).subsume = true;
 
 #ifndef QUIET
   int64_t scheduled = schedule.size ();
@@ -448,8 +448,8 @@ bool Internal::subsume_round () {
     // care. In the same (lazy) spirit we also ignore clauses with fixed
     // literals (false or true).
     //
-    if (c->size > 2 && c->subsume) {
-      c->subsume = false;
+    if (c->size > 2 && cold (c).subsume) {
+      cold (c).subsume = false;
       const int tmp = try_to_subsume_clause (c, shrunken);
       if (tmp > 0) { subsumed++; continue; }
       if (tmp < 0) strengthened++;
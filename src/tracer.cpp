@@ -4,83 +4,268 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
-Tracer::Tracer (Internal * i, File * f, bool b) :
+Tracer::Tracer (Internal * i, File * f, bool b, bool l) :
   internal (i),
-  file (f), binary (b),
+  file (f), binary (b), lrat (0),
   added (0), deleted (0)
+#ifndef NTHREADS
+  , writer (0), stopping (false)
+#endif
 {
   (void) internal;
   LOG ("TRACER new");
+  buffer.reserve (buffer_bytes + 64);
+  if (l) lrat = new LratBuilder (internal, this);
+#ifndef NTHREADS
+  if (file && internal->opts.proofasync) {
+    pending.reserve (buffer_bytes + 64);
+    writer = new std::thread (&Tracer::write, this);
+    LOG ("TRACER started proof writer thread");
+  }
+#endif
 }
 
 Tracer::~Tracer () {
   LOG ("TRACER delete");
+  if (file && !file->closed ()) {
+    if (lrat) lrat->finish ();
+    drain ();
+  }
+#ifndef NTHREADS
+  stop ();
+#endif
+  delete lrat;
   delete file;
 }
 
 /*------------------------------------------------------------------------*/
 
+void Tracer::put (const char * s) {
+  for (const char * p = s; *p; p++)
+    put ((unsigned char) *p);
+}
+
+inline void Tracer::put_text_lit (int lit) {
+  assert (!binary);
+  assert (lit != INT_MIN);
+  char tmp[12];
+  int i = sizeof tmp;
+  unsigned idx = abs (lit);
+  do {
+    assert (i > 0);
+    tmp[--i] = '0' + idx % 10;
+    idx /= 10;
+  } while (idx);
+  if (lit < 0) put ((unsigned char) '-');
+  while (i < (int) sizeof tmp) put ((unsigned char) tmp[i++]);
+}
+
 // Support for binary DRAT format.
 
 inline void Tracer::put_binary_zero () {
   assert (binary);
-  assert (file);
-  file->put ((unsigned char) 0);
+  put ((unsigned char) 0);
 }
 
 inline void Tracer::put_binary_lit (int lit) {
   assert (binary);
-  assert (file);
   assert (lit != INT_MIN);
   unsigned x = 2*abs (lit) + (lit < 0);
   unsigned char ch;
   while (x & ~0x7f) {
     ch = (x & 0x7f) | 0x80;
-    file->put (ch);
+    put (ch);
+    x >>= 7;
+  }
+  ch = x;
+  put (ch);
+}
+
+// Clause identifiers in LRAT are 64-bit.  In binary LRAT they are encoded
+// the same way as positive literals (thus twice their value).
+
+inline void Tracer::put_text_id (uint64_t id) {
+  assert (!binary);
+  char tmp[24];
+  int i = sizeof tmp;
+  do {
+    assert (i > 0);
+    tmp[--i] = '0' + id % 10;
+    id /= 10;
+  } while (id);
+  while (i < (int) sizeof tmp) put ((unsigned char) tmp[i++]);
+}
+
+inline void Tracer::put_binary_id (uint64_t id) {
+  assert (binary);
+  assert (id < ((uint64_t) 1 << 63));
+  uint64_t x = 2*id;
+  unsigned char ch;
+  while (x & ~(uint64_t) 0x7f) {
+    ch = (x & 0x7f) | 0x80;
+    put (ch);
     x >>= 7;
   }
   ch = x;
-  file->put (ch);
+  put (ch);
+}
+
+/*------------------------------------------------------------------------*/
+
+void Tracer::dispatch () {
+  if (buffer.empty ()) return;
+#ifndef NTHREADS
+  if (writer) {
+    {
+      std::unique_lock<std::mutex> lock (mutex);
+      changed.wait (lock, [this] { return pending.empty (); });
+      pending.swap (buffer);
+    }
+    changed.notify_all ();
+    assert (buffer.empty ());
+    return;
+  }
+#endif
+  file->put (buffer.data (), buffer.size ());
+  buffer.clear ();
+}
+
+void Tracer::drain () {
+  dispatch ();
+#ifndef NTHREADS
+  if (!writer) return;
+  std::unique_lock<std::mutex> lock (mutex);
+  changed.wait (lock, [this] { return pending.empty (); });
+#endif
+}
+
+#ifndef NTHREADS
+
+void Tracer::write () {
+  std::unique_lock<std::mutex> lock (mutex);
+  for (;;) {
+    changed.wait (lock, [this] { return stopping || !pending.empty (); });
+    if (pending.empty ()) return;
+    lock.unlock ();
+    file->put (pending.data (), pending.size ());
+    lock.lock ();
+    pending.clear ();
+    changed.notify_all ();
+  }
 }
 
+void Tracer::stop () {
+  if (!writer) return;
+  {
+    std::lock_guard<std::mutex> lock (mutex);
+    stopping = true;
+  }
+  changed.notify_all ();
+  writer->join ();
+  delete writer;
+  writer = 0;
+  LOG ("TRACER stopped proof writer thread");
+}
+
+#endif
+
 /*------------------------------------------------------------------------*/
 
+void Tracer::add_original_clause (const vector<int> & clause) {
+  if (!lrat || file->closed ()) return;
+  lrat->add_original_clause (clause);
+}
+
 void Tracer::add_derived_clause (const vector<int> & clause) {
   if (file->closed ()) return;
+  if (lrat) { lrat->add_derived_clause (clause); return; }
   LOG ("TRACER tracing addition of derived clause");
-  if (binary) file->put ('a');
+  if (binary) put ((unsigned char) 'a');
   for (const auto & external_lit : clause)
     if (binary) put_binary_lit (external_lit);
-    else file->put (external_lit), file->put (' ');
+    else put_text_lit (external_lit), put ((unsigned char) ' ');
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
   added++;
+  if (buffer.size () >= buffer_bytes) dispatch ();
 }
 
 void Tracer::delete_clause (const vector<int> & clause) {
   if (file->closed ()) return;
+  if (lrat) { lrat->delete_clause (clause); return; }
   LOG ("TRACER tracing deletion of clause");
-  if (binary) file->put ('d');
-  else file->put ("d ");
+  if (binary) put ((unsigned char) 'd');
+  else put ("d ");
+  for (const auto & external_lit : clause)
+    if (binary) put_binary_lit (external_lit);
+    else put_text_lit (external_lit), put ((unsigned char) ' ');
+  if (binary) put_binary_zero ();
+  else put ("0\n");
+  deleted++;
+  if (buffer.size () >= buffer_bytes) dispatch ();
+}
+
+// LRAT lines are 'id literals 0 hints 0' for additions and 'id d ids 0'
+// for deletions, where the first 'id' of deletions is the last assigned.
+
+void Tracer::add_lrat_clause (uint64_t id, const vector<int> & clause,
+                              const vector<uint64_t> & hints) {
+  LOG ("TRACER tracing addition of LRAT clause %" PRIu64, id);
+  if (binary) put ((unsigned char) 'a'), put_binary_id (id);
+  else put_text_id (id), put ((unsigned char) ' ');
   for (const auto & external_lit : clause)
     if (binary) put_binary_lit (external_lit);
-    else file->put (external_lit), file->put (' ');
+    else put_text_lit (external_lit), put ((unsigned char) ' ');
+  if (binary) put_binary_zero ();
+  else put ("0 ");
+  for (const auto & hint : hints)
+    if (binary) put_binary_id (hint);
+    else put_text_id (hint), put ((unsigned char) ' ');
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  added++;
+  if (buffer.size () >= buffer_bytes) dispatch ();
+}
+
+void Tracer::delete_lrat_clause (uint64_t last_id, uint64_t id) {
+  LOG ("TRACER tracing deletion of LRAT clause %" PRIu64, id);
+  if (binary) put ((unsigned char) 'd'), put_binary_id (id);
+  else {
+    put_text_id (last_id);
+    put (" d ");
+    put_text_id (id);
+    put (" ");
+  }
+  if (binary) put_binary_zero ();
+  else put ("0\n");
   deleted++;
+  if (buffer.size () >= buffer_bytes) dispatch ();
 }
 
 /*------------------------------------------------------------------------*/
 
 bool Tracer::closed () { return file->closed (); }
 
-void Tracer::close () { assert (!closed ()); file->close (); }
+void Tracer::close () {
+  assert (!closed ());
+  if (lrat) lrat->finish ();
+  drain ();
+#ifndef NTHREADS
+  stop ();
+#endif
+  file->close ();
+}
 
 void Tracer::flush () {
   assert (!closed ());
+  drain ();
   file->flush ();
   MSG ("traced %" PRId64 " added and %" PRId64 " deleted clauses",
     added, deleted);
 }
 
+void Tracer::print_stats () {
+  if (lrat) lrat->print_stats ();
+}
+
 }
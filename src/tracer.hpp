@@ -3,7 +3,14 @@
 
 #include "observer.hpp" // Alphabetically after 'tracer'.
 
-// Proof tracing to a file (actually 'File') in DRAT format.
+#ifndef NTHREADS
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
+// Proof tracing to a file (actually 'File') in DRAT or LRAT format.  For
+// LRAT the clause identifiers and hints are provided by 'LratBuilder'.
 
 namespace CaDiCaL {
 
@@ -12,23 +19,63 @@ class Tracer : public Observer {
   Internal * internal;
   File * file;
   bool binary;
+  LratBuilder * lrat;
 
   int64_t added, deleted;
 
+  // Proof lines are first encoded into 'buffer', which is written to the
+  // file as a whole as soon it is full.  Unless disabled ('--no-proofasync'
+  // or compiled with '-DNTHREADS') a writer thread takes over full buffers,
+  // which keeps file I/O (and compression through pipes) off the critical
+  // path of the solver.  The two buffers are swapped (double buffering).
+
+  static const size_t buffer_bytes = 1 << 20;
+
+  vector<unsigned char> buffer;
+
+  void put (unsigned char ch) { buffer.push_back (ch); }
+  void put (const char *);
+  void put_text_lit (int external_lit);
+
   void put_binary_zero ();
   void put_binary_lit (int external_lit);
 
+  void put_text_id (uint64_t id);
+  void put_binary_id (uint64_t id);
+
+  void dispatch ();     // hand over 'buffer' for writing
+  void drain ();        // wait until all encoded lines are written
+
+#ifndef NTHREADS
+  std::thread * writer;
+  std::mutex mutex;
+  std::condition_variable changed;
+  vector<unsigned char> pending;        // currently written by 'writer'
+  bool stopping;
+  void write ();                        // main function of 'writer'
+  void stop ();
+#endif
+
 public:
 
-  Tracer (Internal *, File * file, bool binary); // own and delete 'file'
-  ~Tracer ();
+  Tracer (Internal *, File * file, bool binary, bool lrat);
+  ~Tracer ();                                     // deletes 'file'
 
+  void add_original_clause (const vector<int> &);
   void add_derived_clause (const vector<int> &);
   void delete_clause (const vector<int> &);
 
+  // Called by 'LratBuilder' to trace LRAT lines.
+  //
+  void add_lrat_clause (uint64_t id, const vector<int> &,
+                        const vector<uint64_t> & hints);
+  void delete_lrat_clause (uint64_t last_id, uint64_t id);
+
   bool closed ();
   void close ();
   void flush ();
+
+  void print_stats ();
 };
 
 }
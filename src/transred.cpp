@@ -42,7 +42,7 @@ void Internal::transred () {
     if (c->garbage) continue;
     if (c->size != 2) continue;
     if (c->redundant && c->hyper) continue;
-    if (!c->transred) break;
+    if (!cold (c).transred) break;
   }
 
   // If all candidate clauses have been checked reschedule all.
@@ -53,7 +53,7 @@ void Internal::transred () {
       "rescheduling all clauses since no clauses to check left");
     for (i = clauses.begin (); i != end; i++) {
       Clause * c = *i;
-      if (c->transred) c->transred = false;
+      if (cold (c).transred) cold (c).transred = false;
     }
     i = clauses.begin ();
   }
@@ -87,8 +87,8 @@ void Internal::transred () {
     if (c->garbage) continue;
     if (c->size != 2) continue;
     if (c->redundant && c->hyper) continue;
-    if (c->transred) continue;                  // checked before?
-    c->transred = true;                         // marked as checked
+    if (cold (c).transred) continue;            // checked before?
+    cold (c).transred = true;                   // marked as checked
 
     LOG (c, "checking transitive reduction of");
 
@@ -134,7 +134,7 @@ void Internal::transred () {
       for (k = ws.begin (); !transitive && !failed && k != eow; k++) {
         const Watch & w = *k;
         if (!w.binary ()) break;        // since we sorted watches above
-        Clause * d = w.clause;
+        Clause * d = w.clause ();
         if (d == c) continue;
         if (irredundant && d->redundant) continue;
         if (d->garbage) continue;
@@ -95,8 +95,8 @@ bool Internal::vivify_propagate () {
         if (!w.binary ()) continue;
         const signed char b = val (w.blit);
         if (b > 0) continue;
-        if (b < 0) conflict = w.clause;                 // but continue
-        else vivify_assign (w.blit, w.clause);
+        if (b < 0) conflict = w.clause ();              // but continue
+        else vivify_assign (w.blit, w.clause ());
       }
     } else if (!conflict && propagated != trail.size ()) {
       const int lit = -trail[propagated++];
@@ -109,16 +109,17 @@ bool Internal::vivify_propagate () {
         const Watch w = *j++ = *i++;
         if (w.binary ()) continue;
         if (val (w.blit) > 0) continue;
-        if (w.clause->garbage) { j--; continue; }
-        if (w.clause == ignore) continue;
-        literal_iterator lits = w.clause->begin ();
+        Clause * c = w.clause ();
+        if (c->garbage) { j--; continue; }
+        if (c == ignore) continue;
+        literal_iterator lits = c->begin ();
         const int other = lits[0]^lits[1]^lit;
         const signed char u = val (other);
         if (u > 0) j[-1].blit = other;
         else {
-          const int size = w.clause->size;
+          const int size = c->size;
           const const_literal_iterator end = lits + size;
-          const literal_iterator middle = lits + w.clause->pos;
+          const literal_iterator middle = lits + c->pos;
           literal_iterator k = middle;
           signed char v = -1;
           int r = 0;
@@ -126,27 +127,27 @@ bool Internal::vivify_propagate () {
             k++;
           if (v < 0) {
             k = lits + 2;
-            assert (w.clause->pos <= size);
+            assert (c->pos <= size);
             while (k != middle && (v = val (r = *k)) < 0)
               k++;
           }
-          w.clause->pos = k - lits;
-          assert (lits + 2 <= k), assert (k <= w.clause->end ());
+          c->pos = k - lits;
+          assert (lits + 2 <= k), assert (k <= c->end ());
           if (v > 0) j[-1].blit = r;
           else if (!v) {
-            LOG (w.clause, "unwatch %d in", r);
+            LOG (c, "unwatch %d in", r);
             lits[0] = other;
             lits[1] = r;
             *k = lit;
-            watch_literal (r, lit, w.clause);
+            watch_literal (r, lit, c);
             j--;
           } else if (!u) {
             assert (v < 0);
-            vivify_assign (other, w.clause);
+            vivify_assign (other, c);
           } else {
             assert (u < 0);
             assert (v < 0);
-            conflict = w.clause;
+            conflict = c;
             break;
           }
         }
@@ -240,8 +241,10 @@ struct vivify_clause_later {
     // First focus on clauses scheduled in the last vivify round but not
     // checked yet since then.
     //
-    if (!a->vivify && b->vivify) return true;
-    if (a->vivify && !b->vivify) return false;
+    const bool a_vivify = internal->cold (a).vivify;
+    const bool b_vivify = internal->cold (b).vivify;
+    if (!a_vivify && b_vivify) return true;
+    if (a_vivify && !b_vivify) return false;
 
     // Among redundant clauses (in redundant mode) prefer small glue.
     //
@@ -346,8 +349,9 @@ bool Internal::consider_to_vivify_clause (Clause * c,
                                           bool redundant_mode) {
   if (c->garbage) return false;
   if (c->redundant != redundant_mode) return false;
-  if (opts.vivifyonce >= 1 && c->redundant && c->vivified) return false;
-  if (opts.vivifyonce >= 2 && !c->redundant && c->vivified) return false;
+  const bool vivified = cold (c).vivified;
+  if (opts.vivifyonce >= 1 && c->redundant && vivified) return false;
+  if (opts.vivifyonce >= 2 && !c->redundant && vivified) return false;
   if (c->redundant && !likely_to_be_kept_clause (c)) return false;
   return true;
 }
@@ -547,8 +551,8 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
   assert (redundant_mode || !c->redundant);
   assert (c->size > 2);                       // see (NO-BINARY) below
 
-  c->vivify = false;                          // mark as checked / tried
-  c->vivified = true;                         // and globally remember
+  cold (c).vivify = false;                    // mark as checked / tried
+  cold (c).vivified = true;                   // and globally remember
 
   if (c->garbage) return;
 
@@ -807,7 +811,7 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
         if (c->redundant) {
 
           assert (redundant_mode);
-          assert (!c->vivify);
+          assert (!cold (c).vivify);
 
         } else {
 
@@ -816,9 +820,9 @@ void Internal::vivify_clause (Vivifier & vivifier, Clause * c) {
           // irredundant clauses.  Thus we schedule it again.
 
           LOG (c, "rescheduling for irredundant round");
-          assert (!c->vivify);
+          assert (!cold (c).vivify);
 
-          c->vivify = true;
+          cold (c).vivify = true;
         }
       }
 
@@ -990,7 +994,7 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
 
     int64_t still_need_to_be_vivified = 0;
     for (const auto & c : vivifier.schedule)
-      if (c->vivify)
+      if (cold (c).vivify)
         still_need_to_be_vivified++;
 
     // Preference clauses scheduled but not vivified yet next time.
@@ -1005,7 +1009,7 @@ void Internal::vivify_round (bool redundant_mode, int64_t propagation_limit) {
       PHASE ("vivify", stats.vivifications,
         "no previously not yet vivified clause left");
       for (const auto & c : vivifier.schedule)
-        c->vivify = true;
+        cold (c).vivify = true;
     }
 
     vivifier.erase ();          // Reclaim  memory early.
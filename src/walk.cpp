@@ -127,7 +127,7 @@ unsigned Internal::walk_break_value (int lit) {
     if (val (w.blit) > 0) continue;
     if (w.binary ()) { res++; continue; }
 
-    Clause * c = w.clause;
+    Clause * c = w.clause ();
     assert (lit == c->literals[0]);
 
     // Now try to find a second satisfied literal starting at 'literals[1]'
@@ -335,7 +335,7 @@ void Internal::walk_flip_lit (Walker & walker, int lit) {
     LOG ("trying to brake %zd watched clauses", ws.size ());
 
     for (const auto & w : ws) {
-      Clause * d = w.clause;
+      Clause * d = w.clause ();
       LOG (d, "unwatch %d in", -lit);
       int * literals = d->literals, replacement = 0, prev = -lit;
       assert (literals[0] == -lit);
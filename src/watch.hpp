@@ -7,27 +7,59 @@
 namespace CaDiCaL {
 
 // Watch lists for CDCL search.  The blocking literal (see also comments
-// related to 'propagate') is a must and thus combining that with a 64 bit
-// pointer will give a 16 byte (8 byte aligned) structure anyhow, which
-// means the additional 4 bytes for the size come for free.  As alternative
-// one could use a 32-bit reference instead of the pointer which would
-// however limit the number of clauses to '2^32 - 1'.  One would also need
-// to use at least one more bit (either taken away from the variable space
-// or the clauses) to denote whether the watch is binary.
+// related to 'propagate') is a must.  Combining that with a 64 bit pointer
+// used to give a 16 byte (8 byte aligned) structure anyhow, where the
+// additional 4 bytes for the size of the clause came for free.  However,
+// the size was only used to determine whether the watched clause is
+// binary.  Since clauses are always allocated 8 byte aligned (see
+// 'Clause::bytes') the least significant bit of the clause pointer is zero
+// and we use it as tag bit for binary clauses instead.  If we further only
+// require 4 byte alignment, the watch fits into 12 bytes, which reduces the
+// memory bandwidth needed for traversing watch lists in 'propagate' by a
+// quarter.  Unaligned 8 byte loads are cheap on the platforms we care
+// about (x86-64 and AArch64).
+
+// As alternative one could use a 32-bit reference instead of the pointer
+// which would however limit the number of clauses to '2^32 - 1' and in
+// addition requires all clauses to be allocated in the arena.  In order to
+// be able to change the layout easily, the rest of the code should only use
+// 'clause ()', 'binary ()' and 'blit' and not depend on the actual layout.
 
 struct Clause;
 
+#pragma pack(push, 4)
+
 struct Watch {
 
-  Clause * clause; int blit;
-  int size;
+  int blit;
+
+private:
 
-  Watch (int b, Clause * c) : clause (c), blit (b), size (c->size) { }
+  uintptr_t tagged;     // Clause pointer with binary tag bit.
+
+  static uintptr_t tag (Clause * c) {
+    const uintptr_t res = (uintptr_t) c;
+    assert (!(res & 1));
+    return res | (c->size == 2);
+  }
+
+public:
+
+  Watch (int b, Clause * c) : blit (b), tagged (tag (c)) { }
   Watch () { }
 
-  bool binary () const { return size == 2; }
+  Clause * clause () const { return (Clause *) (tagged & ~(uintptr_t) 1); }
+  bool binary () const { return tagged & 1; }
+
+  // Update the clause reference, e.g., after moving the clause during
+  // garbage collection, and recompute the binary tag, since the clause
+  // might have been shrunken in the mean time.
+  //
+  void set_clause (Clause * c) { tagged = tag (c); }
 };
 
+#pragma pack(pop)
+
 typedef vector<Watch> Watches;          // of one literal
 
 typedef Watches::iterator watch_iterator;
@@ -38,7 +70,7 @@ inline void remove_watch (Watches & ws, Clause * clause) {
   auto i = ws.begin ();
   for (auto j = i; j != end; j++) {
     const Watch & w = *i++ = *j;
-    if (w.clause == clause) i--;
+    if (w.clause () == clause) i--;
   }
   assert (i + 1 == end);
   ws.resize (i - ws.begin ());
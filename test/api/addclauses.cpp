@@ -0,0 +1,58 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Bulk clause addition with 'add_clauses' and 'add_clause'.
+
+int main () {
+
+  Solver solver;
+
+  // Two complete clauses and an open third clause.
+
+  const int lits[] = { 1, 2, 0, -1, 2, 0, 1, -2 };
+  solver.add_clauses (lits, sizeof lits / sizeof *lits);
+  assert (solver.state () == ADDING);
+
+  // Which is continued and terminated through 'add'.
+
+  solver.add (3);
+  solver.add (0);
+  assert (solver.state () == UNKNOWN);
+
+  // An empty buffer does not change the state.
+
+  solver.add_clauses (lits, 0);
+  assert (solver.state () == UNKNOWN);
+
+  const int clause[] = { -1, -2, 4 };
+  solver.add_clause (clause, sizeof clause / sizeof *clause);
+  assert (solver.state () == UNKNOWN);
+
+  solver.add_clause (vector<int> { -4, -3 });
+  assert (solver.state () == UNKNOWN);
+
+  int res = solver.solve ();
+  cout << "solve returns " << res << endl;
+  assert (res == 10);
+  assert (solver.val (1) > 0);
+  assert (solver.val (2) > 0);
+  assert (solver.val (3) < 0);
+  assert (solver.val (4) > 0);
+
+  solver.add_clause (vector<int> { -2 });
+  res = solver.solve ();
+  cout << "solve returns " << res << endl;
+  assert (res == 20);
+
+  return 0;
+}
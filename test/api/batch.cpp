@@ -0,0 +1,75 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Solving several assumption sets with 'solve_batch'.
+
+struct Results : ResultSink {
+  vector<int> status;
+  vector<vector<int>> failed;
+  Results (size_t n) : status (n, -1), failed (n) { }
+  bool result (size_t query, int res, const vector<int> & f) {
+    cout << "query " << query << " returns " << res << " failed";
+    for (const auto & lit : f) cout << ' ' << lit;
+    cout << endl;
+    assert (query < status.size ());
+    assert (status[query] < 0);
+    status[query] = res;
+    failed[query] = f;
+    return true;
+  }
+};
+
+static bool contains (const vector<int> & v, int lit) {
+  return find (v.begin (), v.end (), lit) != v.end ();
+}
+
+int main () {
+
+  Solver solver;
+
+  // Implications 1 -> 2 -> 3.
+
+  solver.add (-1), solver.add (2), solver.add (0);
+  solver.add (-2), solver.add (3), solver.add (0);
+
+  const vector<vector<int>> queries = {
+    { 1, -3 },          // unsatisfiable, both failed
+    { 1 },              // satisfiable
+    { 4, 1, -2 },       // unsatisfiable, '4' not failed
+    { 1, 3 },           // satisfiable sharing prefix '1'
+    { -3, 4 },          // satisfiable
+  };
+
+  Results results (queries.size ());
+  const size_t solved = solver.solve_batch (queries, results);
+  assert (solved == queries.size ());
+
+  assert (results.status[0] == 20);
+  assert (results.failed[0].size () == 2);
+  assert (contains (results.failed[0], 1));
+  assert (contains (results.failed[0], -3));
+
+  assert (results.status[1] == 10);
+  assert (results.failed[1].empty ());
+
+  assert (results.status[2] == 20);
+  assert (contains (results.failed[2], 1));
+  assert (contains (results.failed[2], -2));
+  assert (!contains (results.failed[2], 4));
+
+  assert (results.status[3] == 10);
+  assert (results.status[4] == 10);
+
+  return 0;
+}
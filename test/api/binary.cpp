@@ -0,0 +1,83 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Round trip of the compact binary CNF format: clauses written with
+// 'write_dimacs' (binary) are read back with 'read_dimacs'.
+
+static string path () {
+  const char * prefix = getenv ("CADICALBUILD");
+  string res = prefix ? prefix : ".";
+  res += "/test-api-binary.bcnf";
+  return res;
+}
+
+struct ClauseCollector : ClauseIterator {
+  vector<vector<int>> clauses;
+  bool clause (const vector<int> & c) {
+    vector<int> sorted = c;
+    sort (sorted.begin (), sorted.end ());
+    clauses.push_back (sorted);
+    return true;
+  }
+};
+
+static vector<vector<int>> clauses (Solver & solver) {
+  ClauseCollector collector;
+  solver.traverse_clauses (collector);
+  sort (collector.clauses.begin (), collector.clauses.end ());
+  return collector.clauses;
+}
+
+int main () {
+
+  Solver writer;
+
+  // Some clauses with large and negative literals, which need more than
+  // one byte in the binary encoding.
+
+  const int vars = 300;
+  for (int i = 1; i + 2 <= vars; i++) {
+    writer.add (i), writer.add (-(i + 1)), writer.add (i + 2);
+    writer.add (0);
+    writer.add (-i), writer.add (vars + 1 - i);
+    writer.add (0);
+  }
+  writer.add (-vars), writer.add (1), writer.add (0);
+
+  const char * error = writer.write_dimacs (path ().c_str (), vars, true);
+  if (error) cout << error << endl;
+  assert (!error);
+
+  Solver reader;
+  int read_vars;
+  error = reader.read_dimacs (path ().c_str (), read_vars);
+  if (error) cout << error << endl;
+  assert (!error);
+  cout << "read " << read_vars << " variables" << endl;
+  assert (read_vars == vars);
+
+  const auto written = clauses (writer), read = clauses (reader);
+  cout << "written " << written.size () << " clauses" << endl;
+  cout << "read " << read.size () << " clauses" << endl;
+  assert (!written.empty ());
+  assert (written == read);
+
+  const int a = writer.solve (), b = reader.solve ();
+  cout << "writer returns " << a << endl;
+  cout << "reader returns " << b << endl;
+  assert (a == b);
+
+  return 0;
+}
@@ -0,0 +1,27 @@
+#include "../../src/ccadical.h"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <assert.h>
+
+int main () {
+  const int lits[] = { -1, 2, 0, 1, 2, 0, -1, -2 };
+  const int clause[] = { 1, -2 };
+  CCaDiCaL * solver = ccadical_init ();
+  int res;
+  ccadical_add_clauses (solver, lits, sizeof lits / sizeof *lits);
+  ccadical_add (solver, 0);
+  res = ccadical_solve (solver);
+  assert (res == 10);
+  res = ccadical_val (solver, 1);
+  assert (res == -1);
+  res = ccadical_val (solver, 2);
+  assert (res == 2);
+  ccadical_add_clause (solver, clause, sizeof clause / sizeof *clause);
+  res = ccadical_solve (solver);
+  assert (res == 20);
+  ccadical_release (solver);
+  return 0;
+}
@@ -0,0 +1,63 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Lookahead scores are reused for all cubes while the formula does not
+// change ('lookaheadcache').  This should not change the generated cubes.
+
+struct Cubes : CubeSink {
+  vector<vector<int>> cubes;
+  bool cube (const vector<int> & c) {
+    cubes.push_back (c);
+    return true;
+  }
+};
+
+// Pigeon hole formula with 'n + 1' pigeons and 'n' holes, where variable
+// 'p*n + h + 1' means that pigeon 'p' sits in hole 'h'.
+
+static void pigeon_hole (Solver & solver, int n) {
+  for (int p = 0; p <= n; p++) {
+    for (int h = 0; h < n; h++)
+      solver.add (p*n + h + 1);
+    solver.add (0);
+  }
+  for (int h = 0; h < n; h++)
+    for (int p = 0; p <= n; p++)
+      for (int q = p + 1; q <= n; q++)
+        solver.add (-(p*n + h + 1)), solver.add (-(q*n + h + 1)),
+        solver.add (0);
+}
+
+static vector<vector<int>> generate (int cache) {
+  Solver solver;
+  solver.set ("lookaheadcache", cache);
+  pigeon_hole (solver, 5);
+  Cubes cubes;
+  int res = solver.generate_cubes (4, cubes);
+  assert (!res);
+  cout << "generated " << cubes.cubes.size ()
+       << " cubes with 'lookaheadcache=" << cache << "'" << endl;
+  for (const auto & cube : cubes.cubes) {
+    for (const auto & lit : cube) cout << lit << ' ';
+    cout << '0' << endl;
+  }
+  return cubes.cubes;
+}
+
+int main () {
+  const auto cached = generate (1);
+  const auto uncached = generate (0);
+  assert (cached.size () == 16);
+  assert (cached == uncached);
+  return 0;
+}
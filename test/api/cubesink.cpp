@@ -0,0 +1,127 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Streaming version of 'generate_cubes' with a 'CubeSink'.
+
+struct Cubes : CubeSink {
+  vector<vector<int>> cubes;
+  bool cube (const vector<int> & c) {
+    cout << "cube";
+    for (const auto & lit : c) cout << ' ' << lit;
+    cout << endl;
+    cubes.push_back (c);
+    return true;
+  }
+};
+
+// Pigeon hole formula with 'n + 1' pigeons and 'n' holes, where variable
+// 'p*n + h + 1' means that pigeon 'p' sits in hole 'h'.  Without the last
+// pigeon the formula is satisfiable.
+
+static void pigeon_hole (Solver & solver, int n, bool unsat) {
+  const int pigeons = unsat ? n + 1 : n;
+  for (int p = 0; p < pigeons; p++) {
+    for (int h = 0; h < n; h++)
+      solver.add (p*n + h + 1);
+    solver.add (0);
+  }
+  for (int h = 0; h < n; h++)
+    for (int p = 0; p < pigeons; p++)
+      for (int q = p + 1; q < pigeons; q++)
+        solver.add (-(p*n + h + 1)), solver.add (-(q*n + h + 1)),
+        solver.add (0);
+}
+
+// Checks that all cubes are different and returns the number of cubes
+// which are satisfiable together with the formula.
+
+static int solve_cubes (int n, bool unsat, const vector<vector<int>> & cubes) {
+  for (size_t i = 0; i < cubes.size (); i++)
+    for (size_t j = i + 1; j < cubes.size (); j++)
+      assert (cubes[i] != cubes[j]);
+  int satisfiable = 0;
+  for (const auto & cube : cubes) {
+    Solver solver;
+    pigeon_hole (solver, n, unsat);
+    for (const auto & lit : cube) solver.assume (lit);
+    const int res = solver.solve ();
+    assert (res == 10 || res == 20);
+    if (res == 10) satisfiable++;
+  }
+  return satisfiable;
+}
+
+int main () {
+
+  // Unsatisfiable formula split up to the maximum depth.  The streamed
+  // cubes are the same as the collected cubes and all are unsatisfiable.
+  {
+    Solver solver;
+    pigeon_hole (solver, 5, true);
+    Cubes sink;
+    const int res = solver.generate_cubes (3, sink);
+    assert (!res);
+    assert (sink.cubes.size () == 8);
+    for (const auto & cube : sink.cubes) assert (cube.size () == 3);
+    assert (!solve_cubes (5, true, sink.cubes));
+
+    Solver other;
+    pigeon_hole (other, 5, true);
+    const auto collected = other.generate_cubes (3);
+    assert (!collected.status);
+    assert (collected.cubes == sink.cubes);
+  }
+
+  // Satisfiable formula, where at least one cube is satisfiable.
+  {
+    Solver solver;
+    pigeon_hole (solver, 5, false);
+    Cubes sink;
+    const int res = solver.generate_cubes (3, sink);
+    assert (!res);
+    assert (!sink.cubes.empty ());
+    assert (solve_cubes (5, false, sink.cubes) > 0);
+  }
+
+  // With a cutoff of all free variables every cube below the minimum depth
+  // becomes a leaf, thus all cubes have exactly the minimum depth.
+  {
+    Solver solver;
+    solver.set ("lookaheadfree", 100);
+    pigeon_hole (solver, 5, true);
+    Cubes sink;
+    const int res = solver.generate_cubes (4, sink, 2);
+    assert (!res);
+    assert (sink.cubes.size () == 4);
+    for (const auto & cube : sink.cubes) assert (cube.size () == 2);
+    assert (!solve_cubes (5, true, sink.cubes));
+  }
+
+  // Formulas solved before splitting yield their status and no cubes.
+  {
+    Solver solver;
+    for (int a = -1; a <= 1; a += 2)
+      for (int b = -2; b <= 2; b += 4)
+        solver.add (a), solver.add (b), solver.add (0);
+    Cubes sink;
+    const int res = solver.generate_cubes (3, sink);
+    assert (res == 20);
+    assert (sink.cubes.empty ());
+
+    const auto collected = solver.generate_cubes (3);
+    assert (collected.status == 20);
+    assert (collected.cubes.empty ());
+  }
+
+  return 0;
+}
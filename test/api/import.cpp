@@ -0,0 +1,81 @@
+#include "../../src/cadical.hpp"
+
+#ifdef NDEBUG
+#undef NDEBUG
+#endif
+
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace CaDiCaL;
+
+// Importing clauses from a connected 'ClauseSource'.
+
+// Pigeon hole formula with 'holes + 1' pigeons, where every clause is
+// extended by the literal '-x'.  This formula implies the unit '-x', which
+// is hard to derive though.  Importing '-x' satisfies all clauses.
+
+static int pigeon (int p, int h, int holes) { return p * holes + h + 1; }
+
+static int formula (Solver & solver, int holes) {
+  const int x = -pigeon (holes + 1, 0, holes);
+  for (int p = 0; p <= holes; p++) {
+    for (int h = 0; h < holes; h++)
+      solver.add (pigeon (p, h, holes));
+    solver.add (x), solver.add (0);
+  }
+  for (int h = 0; h < holes; h++)
+    for (int p = 0; p <= holes; p++)
+      for (int q = p + 1; q <= holes; q++)
+        solver.add (-pigeon (p, h, holes)), solver.add (-pigeon (q, h, holes)),
+        solver.add (x), solver.add (0);
+  return x;
+}
+
+struct UnitSource : ClauseSource {
+  int unit;
+  int calls;
+  UnitSource (int u) : unit (u), calls (0) { }
+  bool import (vector<int> & clause, int & glue) {
+    assert (clause.empty ());
+    if (calls++) return false;
+    clause.push_back (unit);
+    glue = 1;
+    return true;
+  }
+};
+
+int main () {
+
+  const int holes = 9, conflicts = 1000;
+
+  // Lucky phases would find the trivial satisfying assignment.
+
+  Solver without;
+  without.set ("lucky", 0);
+  int x = formula (without, holes);
+  without.limit ("conflicts", conflicts);
+  int res = without.solve ();
+  cout << "without import returns " << res << endl;
+  assert (!res);
+
+  Solver with;
+  with.set ("lucky", 0);
+  x = formula (with, holes);
+  with.freeze (x);
+  UnitSource source (x);
+  with.connect_clause_source (&source);
+  with.limit ("conflicts", conflicts);
+  res = with.solve ();
+  cout << "with import returns " << res << endl;
+  cout << "import called " << source.calls << " times" << endl;
+  with.disconnect_clause_source ();
+  assert (res == 10);
+  assert (source.calls > 1);
+  assert (with.fixed (x) > 0);
+  assert (with.val (x) > 0);
+
+  return 0;
+}
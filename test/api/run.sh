@@ -47,9 +47,11 @@ makefile=$CADICALBUILD/makefile
 
 CXX=`grep '^CXX=' "$makefile"|sed -e 's,CXX=,,'`
 CXXFLAGS=`grep '^CXXFLAGS=' "$makefile"|sed -e 's,CXXFLAGS=,,'`
+LIBS=`grep '^LIBS=' "$makefile"|sed -e 's,LIBS=,,'`
 
 msg "using CXX=$CXX"
 msg "using CXXFLAGS=$CXXFLAGS"
+msg "using LIBS=$LIBS"
 
 tests=../test/api
 
@@ -86,7 +88,7 @@ run () {
   rm -f $name.log $name.o $name
   status=0
   cmd $COMPILE$language -o $name.o -c $src
-  cmd $COMPILE -o $name $name.o -L$CADICALBUILD -lcadical
+  cmd $COMPILE -o $name $name.o -L$CADICALBUILD -lcadical $LIBS
   cmd $name
   if test $status = 0
   then
@@ -110,6 +112,13 @@ run learn
 run cfreeze
 run traverse
 run cipasir
+run import
+run batch
+run binary
+run addclauses
+run caddclauses
+run cubecache
+run cubesink
 
 [ "`grep DNTRACING $makefile`" = "" ] && run apitrace
 
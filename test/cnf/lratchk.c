@@ -0,0 +1,384 @@
+/*
+ * Small independent LRAT proof checker for testing the LRAT proofs
+ * produced with '--lrat'.  Reads the DIMACS file and the proof in text or
+ * binary LRAT format (detected by the first character of the proof) and
+ * checks every added clause by unit propagation on its negation using
+ * exactly the hints given (in order), where the last hint has to become
+ * falsified.  Succeeds only if the empty clause is derived.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+
+static void
+die (const char * msg, ...)
+{
+  va_list ap;
+  fputs ("*** lratchk: ", stdout);
+  va_start (ap, msg);
+  vfprintf (stdout, msg, ap);
+  va_end (ap);
+  fputc ('\n', stdout);
+  fflush (stdout);
+  exit (1);
+}
+
+static void
+msg (const char * msg, ...)
+{
+  va_list ap;
+  fputs ("c [lratchk] ", stdout);
+  va_start (ap, msg);
+  vprintf (msg, ap);
+  va_end (ap);
+  fputc ('\n', stdout);
+  fflush (stdout);
+}
+
+/*------------------------------------------------------------------------*/
+
+typedef struct Clause { int size; int * lits; } Clause;
+
+static Clause * clauses;                /* indexed by clause identifier */
+static uint64_t size_clauses, num_original, last_id;
+
+static signed char * vals;              /* indexed by literal */
+static int size_vars;
+
+static int * trail, size_trail, num_trail;
+
+static int * lits, size_lits, num_lits;                 /* parsed clause */
+static uint64_t * hints, size_hints, num_hints;         /* parsed hints */
+
+static FILE * file;
+static int binary;
+static uint64_t lineno = 1;
+
+static void
+enlarge_vars (int idx)
+{
+  int new_size_vars = size_vars ? 2*size_vars : 2;
+  signed char * new_vals;
+  while (idx >= new_size_vars) new_size_vars *= 2;
+  new_vals = calloc (2*new_size_vars, 1);
+  if (!new_vals) die ("out of memory");
+  new_vals += new_size_vars;
+  if (size_vars)
+    memcpy (new_vals - size_vars, vals - size_vars, 2*size_vars);
+  if (vals) free (vals - size_vars);
+  vals = new_vals;
+  size_vars = new_size_vars;
+  trail = realloc (trail, size_vars * sizeof *trail);
+  if (!trail) die ("out of memory");
+  size_trail = size_vars;
+}
+
+static void
+push_lit (int lit)
+{
+  if (lit == INT32_MIN) die ("invalid literal");
+  if (abs (lit) >= size_vars) enlarge_vars (abs (lit));
+  if (num_lits == size_lits)
+    {
+      size_lits = size_lits ? 2*size_lits : 16;
+      lits = realloc (lits, size_lits * sizeof *lits);
+      if (!lits) die ("out of memory");
+    }
+  lits[num_lits++] = lit;
+}
+
+static void
+push_hint (uint64_t id)
+{
+  if (num_hints == size_hints)
+    {
+      size_hints = size_hints ? 2*size_hints : 16;
+      hints = realloc (hints, size_hints * sizeof *hints);
+      if (!hints) die ("out of memory");
+    }
+  hints[num_hints++] = id;
+}
+
+static Clause *
+find_clause (uint64_t id)
+{
+  if (!id || id >= size_clauses || !clauses[id].lits)
+    return 0;
+  return clauses + id;
+}
+
+static void
+add_clause (uint64_t id)
+{
+  Clause * c;
+  if (id >= size_clauses)
+    {
+      uint64_t new_size_clauses = size_clauses ? 2*size_clauses : 1024;
+      while (id >= new_size_clauses) new_size_clauses *= 2;
+      clauses = realloc (clauses, new_size_clauses * sizeof *clauses);
+      if (!clauses) die ("out of memory");
+      memset (clauses + size_clauses, 0,
+              (new_size_clauses - size_clauses) * sizeof *clauses);
+      size_clauses = new_size_clauses;
+    }
+  c = clauses + id;
+  c->size = num_lits;
+  c->lits = malloc ((num_lits + 1) * sizeof *lits);  /* non-zero if empty */
+  if (!c->lits) die ("out of memory");
+  memcpy (c->lits, lits, num_lits * sizeof *lits);
+}
+
+static void
+delete_clause (uint64_t id)
+{
+  Clause * c = find_clause (id);
+  if (!c) die ("line %llu: deleted clause %llu not found",
+               (unsigned long long) lineno, (unsigned long long) id);
+  free (c->lits);
+  c->lits = 0;
+}
+
+static void
+assign (int lit)
+{
+  assert (!vals[lit]);
+  vals[lit] = 1;
+  vals[-lit] = -1;
+  assert (num_trail < size_trail);
+  trail[num_trail++] = lit;
+}
+
+static void
+backtrack (void)
+{
+  while (num_trail)
+    {
+      int lit = trail[--num_trail];
+      vals[lit] = vals[-lit] = 0;
+    }
+}
+
+/* Returns non-zero if the clause in 'lits' is implied by the hints.
+ */
+static int
+check (uint64_t id)
+{
+  uint64_t i;
+  int j, res = 0;
+  for (j = 0; j < num_lits; j++)
+    {
+      int lit = lits[j];
+      if (vals[lit] > 0) { res = 1; break; }    /* tautological */
+      if (!vals[lit]) assign (-lit);
+    }
+  for (i = 0; !res && i < num_hints; i++)
+    {
+      Clause * c = find_clause (hints[i]);
+      int unit = 0, k;
+      if (!c) die ("line %llu: hint %llu of clause %llu not found",
+                   (unsigned long long) lineno,
+                   (unsigned long long) hints[i], (unsigned long long) id);
+      for (k = 0; k < c->size; k++)
+        {
+          int lit = c->lits[k];
+          signed char tmp = vals[lit];
+          if (tmp < 0) continue;
+          if (tmp > 0)
+            die ("line %llu: hint %llu of clause %llu satisfied",
+                 (unsigned long long) lineno,
+                 (unsigned long long) hints[i], (unsigned long long) id);
+          if (unit && unit != lit)
+            die ("line %llu: hint %llu of clause %llu not unit",
+                 (unsigned long long) lineno,
+                 (unsigned long long) hints[i], (unsigned long long) id);
+          unit = lit;
+        }
+      if (unit) assign (unit);
+      else res = 1;
+    }
+  backtrack ();
+  return res;
+}
+
+/*------------------------------------------------------------------------*/
+
+static void
+parse_dimacs (const char * path)
+{
+  int ch, sign, lit;
+  FILE * dimacs = fopen (path, "r");
+  if (!dimacs) die ("can not read '%s'", path);
+  for (;;)
+    {
+      ch = getc (dimacs);
+      if (ch == EOF) break;
+      if (ch == 'c' || ch == 'p')
+        {
+          while ((ch = getc (dimacs)) != '\n' && ch != EOF)
+            ;
+          continue;
+        }
+      if (ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r') continue;
+      sign = 1;
+      if (ch == '-') sign = -1, ch = getc (dimacs);
+      if (ch < '0' || ch > '9') die ("invalid character in '%s'", path);
+      lit = ch - '0';
+      while ((ch = getc (dimacs)) >= '0' && ch <= '9')
+        lit = 10*lit + (ch - '0');
+      if (lit) push_lit (sign * lit);
+      else add_clause (++num_original), num_lits = 0;
+    }
+  fclose (dimacs);
+  if (num_lits) die ("last clause in '%s' not terminated", path);
+  last_id = num_original;
+  msg ("parsed %llu original clauses", (unsigned long long) num_original);
+}
+
+static int
+next_char (void)
+{
+  int ch = getc (file);
+  if (ch == '\n') lineno++;
+  return ch;
+}
+
+/* Text numbers are separated by white space, binary numbers are encoded
+ * as variable length integers of twice their value (plus sign bit).
+ */
+static int
+read_number (int64_t * res)
+{
+  int ch, sign = 1;
+  uint64_t x = 0;
+  if (binary)
+    {
+      unsigned shift = 0;
+      do
+        {
+          if ((ch = next_char ()) == EOF) return 0;
+          if (shift > 63) die ("number too large");
+          x |= (uint64_t) (ch & 0x7f) << shift;
+          shift += 7;
+        }
+      while (ch & 0x80);
+      *res = (x & 1) ? -(int64_t) (x >> 1) : (int64_t) (x >> 1);
+      return 1;
+    }
+  while ((ch = next_char ()) == ' ' || ch == '\t' || ch == '\n' || ch == '\r')
+    ;
+  if (ch == EOF) return 0;
+  if (ch == 'd') { *res = INT64_MIN; return 1; }
+  if (ch == '-') sign = -1, ch = next_char ();
+  if (ch < '0' || ch > '9')
+    die ("line %llu: expected number", (unsigned long long) lineno);
+  x = ch - '0';
+  while ((ch = next_char ()) >= '0' && ch <= '9')
+    x = 10*x + (ch - '0');
+  *res = sign * (int64_t) x;
+  return 1;
+}
+
+static void
+read_zero_terminated_ids (void)
+{
+  int64_t x;
+  num_hints = 0;
+  for (;;)
+    {
+      if (!read_number (&x)) die ("unexpected end of proof");
+      if (!x) break;
+      if (x < 0) die ("line %llu: negative clause identifier",
+                      (unsigned long long) lineno);
+      push_hint (x);
+    }
+}
+
+static int
+parse_and_check_proof (const char * path)
+{
+  uint64_t added = 0, deleted = 0, i;
+  int64_t id, x;
+  int ch, type = 0, empty = 0;
+  if (!(file = fopen (path, "rb"))) die ("can not read '%s'", path);
+  ch = getc (file);
+  binary = (ch == 'a' || ch == 'd');
+  if (ch != EOF) ungetc (ch, file);
+  msg ("reading %s LRAT proof '%s'", binary ? "binary" : "text", path);
+  for (;;)
+    {
+      if (binary)
+        {
+          if ((type = next_char ()) == EOF) break;
+          if (type != 'a' && type != 'd')
+            die ("invalid binary line type");
+          if (type == 'd')
+            {
+              read_zero_terminated_ids ();
+              for (i = 0; i < num_hints; i++) delete_clause (hints[i]);
+              deleted += num_hints;
+              continue;
+            }
+          if (!read_number (&id)) die ("unexpected end of proof");
+        }
+      else
+        {
+          if (!read_number (&id)) break;
+          if (!read_number (&x)) die ("unexpected end of proof");
+          if (x == INT64_MIN)
+            {
+              read_zero_terminated_ids ();
+              for (i = 0; i < num_hints; i++) delete_clause (hints[i]);
+              deleted += num_hints;
+              continue;
+            }
+        }
+      if (id <= 0 || (uint64_t) id <= last_id)
+        die ("line %llu: clause identifier %lld not increasing",
+             (unsigned long long) lineno, (long long) id);
+      num_lits = 0;
+      if (binary && !read_number (&x)) die ("unexpected end of proof");
+      while (x)
+        {
+          if (x == INT64_MIN || x < INT32_MIN + 1 || x > INT32_MAX)
+            die ("line %llu: invalid literal", (unsigned long long) lineno);
+          push_lit ((int) x);
+          if (!read_number (&x)) die ("unexpected end of proof");
+        }
+      read_zero_terminated_ids ();
+      if (!check (id))
+        die ("clause %lld not implied by its hints", (long long) id);
+      add_clause (id);
+      last_id = id;
+      added++;
+      if (!num_lits)
+        {
+          msg ("derived empty clause %lld", (long long) id);
+          empty = 1;
+          break;
+        }
+    }
+  fclose (file);
+  msg ("checked %llu added and %llu deleted clauses",
+       (unsigned long long) added, (unsigned long long) deleted);
+  return empty;
+}
+
+int
+main (int argc, char ** argv)
+{
+  uint64_t i;
+  if (argc != 3) die ("usage: lratchk <dimacs> <lrat-proof>");
+  parse_dimacs (argv[1]);
+  if (!parse_and_check_proof (argv[2])) die ("empty clause not derived");
+  for (i = 0; i < size_clauses; i++) free (clauses[i].lits);
+  free (clauses);
+  free (lits);
+  free (hints);
+  free (trail);
+  if (vals) free (vals - size_vars);
+  printf ("s VERIFIED\n");
+  return 0;
+}
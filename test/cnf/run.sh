@@ -43,6 +43,7 @@ res=$?
 coresolver="$CADICALBUILD/cadical"
 simpsolver="$CADICALBUILD/../scripts/run-simplifier-and-extend-solution.sh"
 proofchecker=$CADICALBUILD/drat-trim
+lratchecker=$CADICALBUILD/lratchk
 solutionchecker=$CADICALBUILD/precochk
 makefile=$CADICALBUILD/makefile
 
@@ -80,12 +81,68 @@ else
   msg "external proof checking with '$proofchecker'"
 fi
 
+if [ ! -f $lratchecker -o ../test/cnf/lratchk.c -nt $lratchecker ]
+then
+  cmd="cc -O -o $lratchecker ../test/cnf/lratchk.c"
+  if $cmd 2>/dev/null
+  then
+    msg "external LRAT proof checking with '$lratchecker'"
+  else
+    msg "no external LRAT proof checking " \
+        "(compiling '../test/cnf/lratchk.c' failed)"
+    lratchecker=none
+  fi
+else
+  msg "external LRAT proof checking with '$lratchecker'"
+fi
+
 
 #--------------------------------------------------------------------------#
 
 ok=0
 failed=0
 
+# Generate an LRAT proof in the format given as second argument and check
+# it with the LRAT checker (called for unsatisfiable instances only).
+
+lrat () {
+  prefix=$CADICALBUILD/test-cnf-lrat
+  cnf=../test/cnf/$1.cnf
+  prf=$prefix-$1-$2.lrat
+  log=$prefix-$1-$2.log
+  err=$prefix-$1-$2.err
+  chk=$prefix-$1-$2.chk
+  if [ $2 = text ]
+  then
+    opts="$cnf --lrat --no-binary $prf"
+  else
+    opts="$cnf --lrat $prf"
+  fi
+  cecho "$coresolver \\"
+  cecho "$opts"
+  cecho -n "# 20 ..."
+  "$coresolver" $opts 1>$log 2>$err
+  res=$?
+  if [ ! $res = 20 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+    failed=`expr $failed + 1`
+    return
+  fi
+  cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+  cecho "$lratchecker \\"
+  cecho "$cnf $prf"
+  cecho -n "# 0 ..."
+  if $lratchecker $cnf $prf 1>&2 >$chk
+  then
+    cecho " ${GOOD}ok${NORMAL} ($2 LRAT proof checked)"
+    ok=`expr $ok + 1`
+  else
+    cecho " ${BAD}FAILED${NORMAL} (LRAT proof check '$lratchecker $cnf $prf' failed)"
+    failed=`expr $failed + 1`
+  fi
+}
+
 core () {
   msg "running CNF test core ${HILITE}'$1'${NORMAL}"
   prefix=$CADICALBUILD/test-cnf-core
@@ -157,6 +214,11 @@ core () {
 	failed=`expr $failed + 1`
       fi
     fi
+    if [ ! x"$lratchecker" = xnone ]
+    then
+      lrat $1 text
+      lrat $1 binary
+    fi
   else 
     cecho " ${BAD}FAILED${NORMAL} (unsupported exit code $res)"
     failed=`expr $failed + 1`
@@ -207,6 +269,93 @@ run () {
   simp $*
 }
 
+# Compressed files are read (and decompressed) without any warning.
+
+compressed () {
+  msg "running CNF test compressed ${HILITE}'$1'${NORMAL}"
+  prefix=$CADICALBUILD/test-cnf-compressed
+  cnf=../test/cnf/$1
+  log=$prefix-$1.log
+  err=$prefix-$1.err
+  cecho "$coresolver \\"
+  cecho "$cnf"
+  cecho -n "# $2 ..."
+  "$coresolver" $cnf 1>$log 2>$err
+  res=$?
+  if [ ! $res = $2 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+    failed=`expr $failed + 1`
+  elif [ -s $err ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (unexpected messages in '$err')"
+    failed=`expr $failed + 1`
+  else
+    cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+    ok=`expr $ok + 1`
+  fi
+}
+
+# In portfolio mode the proof of the winning worker is copied to the DRAT
+# proof file, which thus has to be checked as for a single solver.
+
+portfolio () {
+  msg "running CNF test portfolio ${HILITE}'$1'${NORMAL}"
+  prefix=$CADICALBUILD/test-cnf-portfolio
+  cnf=../test/cnf/$1.cnf
+  prf=$prefix-$1.prf
+  log=$prefix-$1.log
+  err=$prefix-$1.err
+  chk=$prefix-$1.chk
+  if [ ! $2 = 20 -o x"$proofchecker" = xnone ]
+  then
+    opts="$cnf --threads=2"
+  else
+    opts="$cnf --threads=2 $prf"
+  fi
+  cecho "$coresolver \\"
+  cecho "$opts"
+  cecho -n "# $2 ..."
+  "$coresolver" $opts 1>$log 2>$err
+  res=$?
+  if [ ! $res = $2 ]
+  then
+    cecho " ${BAD}FAILED${NORMAL} (actual exit code $res)"
+    failed=`expr $failed + 1`
+    return
+  fi
+  cecho " ${GOOD}ok${NORMAL} (exit code as expected)"
+  if [ $res = 10 -a ! x"$solutionchecker" = xnone ]
+  then
+    cecho "$solutionchecker \\"
+    cecho "$cnf $log"
+    cecho -n "# 0 ..."
+    if $solutionchecker $cnf $log 1>&2 >$chk
+    then
+      cecho " ${GOOD}ok${NORMAL} (solution checked externally)"
+      ok=`expr $ok + 1`
+    else
+      cecho " ${BAD}FAILED${NORMAL} (incorrect solution)"
+      failed=`expr $failed + 1`
+    fi
+  elif [ $res = 20 -a ! x"$proofchecker" = xnone ]
+  then
+    cecho "$proofchecker \\"
+    cecho "$cnf $prf"
+    cecho -n "# 0 ..."
+    if $proofchecker $cnf $prf 1>&2 >$chk
+    then
+      cecho " ${GOOD}ok${NORMAL} (proof checked)"
+      ok=`expr $ok + 1`
+    else
+      cecho " ${BAD}FAILED${NORMAL} (proof check '$proofchecker $cnf $prf' failed)"
+      failed=`expr $failed + 1`
+    fi
+  else
+    ok=`expr $ok + 1`
+  fi
+}
+
 run empty 10
 run false 20
 
@@ -304,6 +453,21 @@ run add128 20
 
 run prime65537 20
 
+# Decompress to exactly one chunk of the in-process decompressor.
+
+compressed chunk1m.cnf.gz 10
+compressed chunk1mcat.cnf.gz 10
+compressed chunk1m.cnf.xz 10
+
+if [ x"`$coresolver --build 2>/dev/null|grep NTHREADS`" = x ]
+then
+  portfolio prime2209 10
+  portfolio sqrt10201 10
+  portfolio ph6 20
+  portfolio add16 20
+  portfolio prime65537 20
+fi
+
 #--------------------------------------------------------------------------#
 
 [ $ok -gt 0 ] && OK="$GOOD"
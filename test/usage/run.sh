@@ -118,6 +118,44 @@ do
   run 20 $option ../test/cnf/add16.cnf
 done
 
+# Cube generation with parallel lookahead probing.
+
+for option in --lookaheadthreads=1 --lookaheadthreads=2 --lookaheadthreads=4
+do
+  run 10 --cubes=4 $option ../test/cnf/prime2209.cnf
+  run 20 --cubes=4 $option ../test/cnf/ph6.cnf
+done
+
+# Cubes with few free variables left are not split further.
+
+for option in --lookaheadfree=10 --lookaheadfree=50 --lookaheadfree=100
+do
+  run 10 --cubes=8 $option ../test/cnf/prime2209.cnf
+  run 20 --cubes=8 $option ../test/cnf/ph6.cnf
+done
+
+# Cube and conquer with parallel workers, which split open cubes.
+
+if [ x"`$solver --build 2>/dev/null|grep NTHREADS`" = x ]
+then
+  for option in \
+    "--threads=4 --cubes=4" \
+    "--threads=4 --cubes=4 --split=100" \
+    "--threads=2 --cubes=1 --split=10"
+  do
+    run 10 $option ../test/cnf/prime2209.cnf
+    run 20 $option ../test/cnf/ph6.cnf
+    run 20 $option ../test/cnf/add16.cnf
+  done
+
+  # Portfolio mode can neither compress nor generate LRAT proofs.
+
+  run 1 --threads=2 ../test/cnf/ph6.cnf $CADICALBUILD/test-usage.drat.gz
+  run 1 --threads=2 ../test/cnf/ph6.cnf $CADICALBUILD/test-usage.drat.xz
+  run 1 --threads=2 --lrat ../test/cnf/ph6.cnf $CADICALBUILD/test-usage.lrat
+  run 1 --threads=2 --cubes=2 ../test/cnf/ph6.cnf $CADICALBUILD/test-usage.drat
+fi
+
 # run 0 -t
 # run 0 -O
 # run 0 -c 0